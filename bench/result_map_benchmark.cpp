@@ -0,0 +1,71 @@
+// Counts the errors of the stream per error value with result_map (direct
+// array for 8 bit results, hashed table for 32 bit ones) and with
+// std::unordered_map keyed by the same results.
+
+#include "respp/hash.hpp"
+#include "respp/result_map.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+MAKE_RESULT_CATEGORY(Category, 2);
+MAKE_RESULT_CATEGORY(SubCategory, 2);
+MAKE_RESULT_TYPE(Result, uint8_t, Category, SubCategory);
+MAKE_RESULT_TYPE(WideResult, uint32_t, Category, SubCategory);
+
+constexpr auto Backend = Category{2};
+constexpr auto Rpc = SubCategory{2};
+
+constexpr size_t stream_length = 4096;
+constexpr uint32_t distinct_errors = 12;
+
+template <typename R>
+std::vector<R> make_stream()
+{
+    std::vector<R> stream;
+    uint32_t state = 1;
+    for (size_t i = 0; i < stream_length; ++i) {
+        state = state * 1664525u + 1013904223u;
+        stream.push_back(
+            R::make(Backend, Rpc, (state >> 8) % distinct_errors + 1));
+    }
+    return stream;
+}
+
+template <typename R>
+void ResultMap(benchmark::State &state)
+{
+    auto const stream = make_stream<R>();
+    for (auto _ : state) {
+        respp::result_map<R, uint32_t, 32> counters{};
+        for (auto const &r : stream)
+            ++*counters.insert(r);
+        benchmark::DoNotOptimize(counters);
+    }
+    state.SetItemsProcessed(state.iterations() * stream_length);
+}
+BENCHMARK_TEMPLATE(ResultMap, Result);
+BENCHMARK_TEMPLATE(ResultMap, WideResult);
+
+template <typename R>
+void UnorderedMap(benchmark::State &state)
+{
+    auto const stream = make_stream<R>();
+    for (auto _ : state) {
+        std::unordered_map<R, uint32_t> counters;
+        for (auto const &r : stream)
+            ++counters[r];
+        benchmark::DoNotOptimize(counters);
+    }
+    state.SetItemsProcessed(state.iterations() * stream_length);
+}
+BENCHMARK_TEMPLATE(UnorderedMap, Result);
+BENCHMARK_TEMPLATE(UnorderedMap, WideResult);
+
+}  // namespace
+
+BENCHMARK_MAIN();
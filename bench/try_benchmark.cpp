@@ -0,0 +1,190 @@
+// Compares the success path of the layered calls propagating failures with
+// the inline branches (the examples/example.cpp pattern) and via RESPP_TRY
+// that moves the failure handling out of line. The small call chain fits into
+// the instruction cache, the many distinct call sites of *Sites benchmarks
+// do not with the inline failure handling.
+
+#include "respp/try.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <utility>
+
+namespace
+{
+MAKE_RESULT_CATEGORY(Category, 2);
+MAKE_RESULT_CATEGORY(SubCategory, 2);
+MAKE_RESULT_TYPE(Result, uint8_t, Category, SubCategory);
+MAKE_AGGREGATE_RESULT_TYPE(AggregateResult, uint32_t, Result);
+
+constexpr auto Backend = Category{2};
+constexpr auto Ui = Category{1};
+constexpr auto Rpc = SubCategory{2};
+constexpr auto DataAccess = SubCategory{3};
+constexpr auto DataModel = SubCategory{1};
+
+constexpr auto rpcError = Result::make(Backend, Rpc, 1);
+constexpr auto backendAccessError = Result::make(Backend, DataAccess, 2);
+constexpr auto dataRetrievalError = Result::make(Ui, DataModel, 1);
+constexpr auto requestError = Result::make(Ui, DataModel, 2);
+
+// one failure per 1024 calls
+unsigned counter = 0;
+
+[[gnu::noinline]] Result executeRemoteQuery()
+{
+    return (++counter & 1023) ? Result::success : rpcError;
+}
+
+namespace inline_branches
+{
+[[gnu::noinline]] AggregateResult retrieveRemoteData()
+{
+    auto const result = executeRemoteQuery();
+    if (!respp::is_success(result)) {
+        AggregateResult aggregate{result};
+        return aggregate << backendAccessError;
+    }
+    return {};
+}
+
+[[gnu::noinline]] AggregateResult retrieveData()
+{
+    auto result = retrieveRemoteData();
+    if (!respp::is_success(result))
+        return result << dataRetrievalError;
+    return {};
+}
+
+[[gnu::noinline]] AggregateResult handleRequest()
+{
+    auto result = retrieveData();
+    if (!respp::is_success(result))
+        return result << requestError;
+    return {};
+}
+}  // namespace inline_branches
+
+namespace outlined
+{
+[[gnu::noinline]] AggregateResult retrieveRemoteData()
+{
+    RESPP_TRY(executeRemoteQuery(), backendAccessError);
+    return {};
+}
+
+[[gnu::noinline]] AggregateResult retrieveData()
+{
+    RESPP_TRY(retrieveRemoteData(), dataRetrievalError);
+    return {};
+}
+
+[[gnu::noinline]] AggregateResult handleRequest()
+{
+    RESPP_TRY(retrieveData(), requestError);
+    return {};
+}
+}  // namespace outlined
+
+constexpr size_t call_sites = 1024;
+
+constexpr Result siteError(size_t site, unsigned check)
+{
+    return Result::make(
+        Backend, DataAccess, static_cast<uint8_t>((site + check) % 15 + 1));
+}
+
+using site_function = AggregateResult (*)();
+
+template <
+    template <size_t>
+    class Site,
+    size_t... Sites>
+constexpr std::array<site_function, sizeof...(Sites)> makeSites(
+    std::index_sequence<Sites...>)
+{
+    return {{&Site<Sites>::call...}};
+}
+
+namespace inline_branches
+{
+template <size_t Id>
+struct Site {
+    [[gnu::noinline]] static AggregateResult call()
+    {
+        auto result = executeRemoteQuery();
+        if (!respp::is_success(result)) {
+            AggregateResult aggregate{result};
+            return aggregate << siteError(Id, 1);
+        }
+        result = executeRemoteQuery();
+        if (!respp::is_success(result)) {
+            AggregateResult aggregate{result};
+            return aggregate << siteError(Id, 2);
+        }
+        result = executeRemoteQuery();
+        if (!respp::is_success(result)) {
+            AggregateResult aggregate{result};
+            return aggregate << siteError(Id, 3);
+        }
+        return {};
+    }
+};
+}  // namespace inline_branches
+
+namespace outlined
+{
+template <size_t Id>
+struct Site {
+    [[gnu::noinline]] static AggregateResult call()
+    {
+        RESPP_TRY(executeRemoteQuery(), siteError(Id, 1));
+        RESPP_TRY(executeRemoteQuery(), siteError(Id, 2));
+        RESPP_TRY(executeRemoteQuery(), siteError(Id, 3));
+        return {};
+    }
+};
+}  // namespace outlined
+
+template <template <size_t> class Site>
+void callSites(benchmark::State &state)
+{
+    static constexpr auto sites
+        = makeSites<Site>(std::make_index_sequence<call_sites>{});
+    for (auto _ : state) {
+        for (auto const site : sites)
+            benchmark::DoNotOptimize(site());
+    }
+    state.SetItemsProcessed(state.iterations() * call_sites);
+}
+
+void InlineBranches(benchmark::State &state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(inline_branches::handleRequest());
+}
+BENCHMARK(InlineBranches);
+
+void ResppTry(benchmark::State &state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(outlined::handleRequest());
+}
+BENCHMARK(ResppTry);
+
+void InlineBranchesSites(benchmark::State &state)
+{
+    callSites<inline_branches::Site>(state);
+}
+BENCHMARK(InlineBranchesSites);
+
+void ResppTrySites(benchmark::State &state)
+{
+    callSites<outlined::Site>(state);
+}
+BENCHMARK(ResppTrySites);
+
+}  // namespace
+
+BENCHMARK_MAIN();
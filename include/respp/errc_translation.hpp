@@ -0,0 +1,114 @@
+#pragma once
+
+#include "respp/translation.hpp"
+
+#include <system_error>
+
+namespace respp
+{
+// Generic conditions the system error codes are grouped into, fit 4 bits of
+// the result code
+enum class errc_code : uint8_t {
+    invalid_argument = 1,
+    permission_denied,
+    not_found,
+    already_exists,
+    busy,
+    timed_out,
+    out_of_resources,
+    connection_failure,
+    io_error,
+    not_supported,
+    interrupted,
+    other = 15
+};
+
+// Default translation tables for errno values and std::errc. The derived
+// table places the condition into the project result type:
+//
+// struct SystemErrors : respp::errno_table<SystemErrors> {
+//     static constexpr Result make(respp::errc_code code)
+//     {
+//         return Result::make(Backend, Os, static_cast<uint8_t>(code));
+//     }
+// };
+// auto const r = respp::translation_t<SystemErrors>::to_result(errno);
+//
+// Zero (no error) is translated to success, the codes not listed to
+// errc_code::other.
+template <typename Derived, typename Code>
+struct basic_errc_table {
+    static constexpr auto mappings()
+    {
+        using result = decltype(Derived::make(errc_code::other));
+        using e = std::errc;
+        using c = errc_code;
+        return make_code_mappings<Code, result>(
+            Derived::make(c::other),
+            {{Code(0), result::success},
+             {Code(e::invalid_argument), Derived::make(c::invalid_argument)},
+             {Code(e::argument_out_of_domain),
+              Derived::make(c::invalid_argument)},
+             {Code(e::result_out_of_range), Derived::make(c::invalid_argument)},
+             {Code(e::bad_file_descriptor), Derived::make(c::invalid_argument)},
+             {Code(e::filename_too_long), Derived::make(c::invalid_argument)},
+             {Code(e::argument_list_too_long),
+              Derived::make(c::invalid_argument)},
+             {Code(e::permission_denied), Derived::make(c::permission_denied)},
+             {Code(e::operation_not_permitted),
+              Derived::make(c::permission_denied)},
+             {Code(e::read_only_file_system),
+              Derived::make(c::permission_denied)},
+             {Code(e::no_such_file_or_directory), Derived::make(c::not_found)},
+             {Code(e::no_such_process), Derived::make(c::not_found)},
+             {Code(e::no_such_device), Derived::make(c::not_found)},
+             {Code(e::no_such_device_or_address), Derived::make(c::not_found)},
+             {Code(e::file_exists), Derived::make(c::already_exists)},
+             {Code(e::device_or_resource_busy), Derived::make(c::busy)},
+             {Code(e::resource_unavailable_try_again), Derived::make(c::busy)},
+             {Code(e::operation_would_block), Derived::make(c::busy)},
+             {Code(e::operation_in_progress), Derived::make(c::busy)},
+             {Code(e::connection_already_in_progress), Derived::make(c::busy)},
+             {Code(e::text_file_busy), Derived::make(c::busy)},
+             {Code(e::timed_out), Derived::make(c::timed_out)},
+             {Code(e::not_enough_memory), Derived::make(c::out_of_resources)},
+             {Code(e::no_space_on_device), Derived::make(c::out_of_resources)},
+             {Code(e::too_many_files_open), Derived::make(c::out_of_resources)},
+             {Code(e::too_many_files_open_in_system),
+              Derived::make(c::out_of_resources)},
+             {Code(e::no_buffer_space), Derived::make(c::out_of_resources)},
+             {Code(e::too_many_links), Derived::make(c::out_of_resources)},
+             {Code(e::connection_refused),
+              Derived::make(c::connection_failure)},
+             {Code(e::connection_reset), Derived::make(c::connection_failure)},
+             {Code(e::connection_aborted),
+              Derived::make(c::connection_failure)},
+             {Code(e::not_connected), Derived::make(c::connection_failure)},
+             {Code(e::broken_pipe), Derived::make(c::connection_failure)},
+             {Code(e::host_unreachable), Derived::make(c::connection_failure)},
+             {Code(e::network_unreachable),
+              Derived::make(c::connection_failure)},
+             {Code(e::network_down), Derived::make(c::connection_failure)},
+             {Code(e::network_reset), Derived::make(c::connection_failure)},
+             {Code(e::address_in_use), Derived::make(c::connection_failure)},
+             {Code(e::address_not_available),
+              Derived::make(c::connection_failure)},
+             {Code(e::io_error), Derived::make(c::io_error)},
+             {Code(e::function_not_supported), Derived::make(c::not_supported)},
+             {Code(e::not_supported), Derived::make(c::not_supported)},
+             {Code(e::operation_not_supported),
+              Derived::make(c::not_supported)},
+             {Code(e::address_family_not_supported),
+              Derived::make(c::not_supported)},
+             {Code(e::protocol_not_supported), Derived::make(c::not_supported)},
+             {Code(e::interrupted), Derived::make(c::interrupted)}});
+    }
+};
+
+template <typename Derived>
+using errno_table = basic_errc_table<Derived, int>;
+
+template <typename Derived>
+using errc_table = basic_errc_table<Derived, std::errc>;
+
+}  // namespace respp
@@ -0,0 +1,326 @@
+#pragma once
+
+#include "respp/result.hpp"
+
+#include <initializer_list>
+
+namespace respp
+{
+// Fixed capacity tree of results keeping the causal relation between them:
+// the causes of the node are its children. Parent indices are bit-packed
+// into 64-bit words and every node has a flag telling whether its subtree
+// contains a failure.
+//
+// The tree can be used in place of aggregate result: appended result becomes
+// the parent (context) of the current root. As in aggregate result success
+// values occupy no space and results appended to the full tree are dropped.
+template <typename Result, uint8_t Capacity>
+class error_tree_t {
+public:
+    using result = Result;
+    using index_type = uint8_t;
+
+    static constexpr uint8_t capacity = Capacity;
+    static_assert(
+        capacity >= 2 && capacity <= 64,
+        "The error tree should have space for 2 up to 64 errors");
+
+    // index of the absent node (parent of the root, result of the failed
+    // append), the smallest value not fitting into the tree
+    static constexpr index_type npos = capacity;
+
+    static constexpr error_tree_t success{};
+
+    // Traverses the subtree in post-order (causes before their context, the
+    // order of aggregate result) or in pre-order (context first)
+    template <bool Postorder>
+    class node_iterator {
+    public:
+        node_iterator() : m_tree(nullptr), m_index(npos), m_subtree(npos)
+        {}
+
+        node_iterator(error_tree_t const &tree, index_type subtree_root)
+            : m_tree(&tree)
+            , m_index(
+                  Postorder ? tree.first_leaf(subtree_root)
+                            : tree.node_or_npos(subtree_root))
+            , m_subtree(tree.node_or_npos(subtree_root))
+        {}
+
+        node_iterator operator++()
+        {
+            m_index = Postorder
+                          ? m_tree->next_in_postorder(m_index, m_subtree)
+                          : m_tree->next_in_preorder(m_index, m_subtree);
+            return *this;
+        }
+
+        node_iterator operator++(int)
+        {
+            auto const previous_iterator(*this);
+            ++*this;
+            return previous_iterator;
+        }
+
+        result const &operator*() const
+        {
+            return (*m_tree)[m_index];
+        }
+
+        // index of the node in the tree
+        index_type index() const
+        {
+            return m_index;
+        }
+
+        friend bool operator==(
+            node_iterator const &lhs, node_iterator const &rhs)
+        {
+            return lhs.m_index == rhs.m_index;
+        }
+
+        friend bool operator!=(
+            node_iterator const &lhs, node_iterator const &rhs)
+        {
+            return lhs.m_index != rhs.m_index;
+        }
+
+    private:
+        error_tree_t const *m_tree;
+        index_type m_index;
+        index_type m_subtree;
+    };
+
+    using postorder_iterator = node_iterator<true>;
+    using preorder_iterator = node_iterator<false>;
+
+    constexpr error_tree_t() = default;
+
+    constexpr error_tree_t(std::initializer_list<result> results)
+    {
+        for (auto const &r : results) {
+            append(r);
+        }
+    }
+
+    constexpr error_tree_t(result const &result)
+    {
+        append(result);
+    }
+
+    constexpr index_type size() const
+    {
+        return m_size;
+    }
+
+    constexpr index_type root() const
+    {
+        return m_size ? m_root : npos;
+    }
+
+    constexpr index_type parent(index_type index) const
+    {
+        return static_cast<index_type>(
+            (m_parents[index / parents_per_word]
+             >> (index % parents_per_word * index_bits))
+            & index_mask);
+    }
+
+    constexpr result const &operator[](index_type index) const
+    {
+        return m_results[index];
+    }
+
+    // O(1): the node or any of its (transitive) causes is not a success
+    constexpr bool any_failure_under(index_type index) const
+    {
+        return index < m_size && ((m_subtree_failures >> index) & 1);
+    }
+
+    // adds the cause to the parent node, returns index of the added node
+    constexpr index_type append_child(index_type parent_index, result const &r)
+    {
+        if (m_size == capacity || parent_index >= m_size)
+            return npos;
+
+        auto const index = m_size++;
+        m_results[index] = r;
+        set_parent(index, parent_index);
+        if (!is_success(r)) {
+            // the ancestors' flags are already set if the parent has one
+            for (auto i = index; i != npos && !any_failure_under(i);
+                 i = parent(i))
+                m_subtree_failures |= uint64_t{1} << i;
+        }
+        return index;
+    }
+
+    // adds the context to the root, returns index of the new root
+    constexpr index_type append_parent(result const &r)
+    {
+        if (m_size == capacity)
+            return npos;
+
+        auto const index = m_size++;
+        m_results[index] = r;
+        set_parent(index, npos);
+        if (index) {
+            set_parent(m_root, index);
+            if (any_failure_under(m_root))
+                m_subtree_failures |= uint64_t{1} << index;
+        }
+        if (!is_success(r))
+            m_subtree_failures |= uint64_t{1} << index;
+        m_root = index;
+        return index;
+    }
+
+    constexpr void append(result const &r)
+    {
+        if (!is_success(r))
+            append_parent(r);
+    }
+
+    // Post-order traversal from the root: the causes precede their context,
+    // so a chain of appended results is visited as in aggregate result
+    iterator_pair<postorder_iterator> iterate_errors() const
+    {
+        return iterate_subtree(root());
+    }
+
+    iterator_pair<postorder_iterator> iterate_subtree(index_type index) const
+    {
+        return make_iterator_pair(
+            postorder_iterator(*this, index), postorder_iterator{});
+    }
+
+    // pre-order traversal, the causes follow their context
+    iterator_pair<preorder_iterator> iterate_preorder() const
+    {
+        return iterate_preorder(root());
+    }
+
+    iterator_pair<preorder_iterator> iterate_preorder(index_type index) const
+    {
+        return make_iterator_pair(
+            preorder_iterator(*this, index), preorder_iterator{});
+    }
+
+    friend error_tree_t &operator<<(error_tree_t &t, result const &r)
+    {
+        t.append(r);
+        return t;
+    }
+
+    friend constexpr bool operator==(
+        error_tree_t const &lhs, error_tree_t const &rhs)
+    {
+        if (lhs.m_size != rhs.m_size || lhs.root() != rhs.root())
+            return false;
+        for (index_type i = 0; i < lhs.m_size; ++i)
+            if (!(lhs.m_results[i] == rhs.m_results[i])
+                || lhs.parent(i) != rhs.parent(i))
+                return false;
+        return true;
+    }
+
+private:
+    static constexpr uint8_t index_bits = detail::bit_width(npos);
+    static constexpr uint8_t parents_per_word = 64 / index_bits;
+    static constexpr uint8_t parent_words
+        = (capacity + parents_per_word - 1) / parents_per_word;
+    static constexpr uint64_t index_mask = (uint64_t{1} << index_bits) - 1;
+
+    static constexpr bool is_success(result const &r)
+    {
+        return result::success == r;
+    }
+
+    constexpr void set_parent(index_type index, index_type parent_index)
+    {
+        auto const shift = index % parents_per_word * index_bits;
+        auto &word = m_parents[index / parents_per_word];
+        word = (word & ~(index_mask << shift))
+               | (static_cast<uint64_t>(parent_index) << shift);
+    }
+
+    // children are ordered by index, the search starts from the given one
+    index_type find_child(index_type parent_index, index_type from) const
+    {
+        for (auto i = from; i < m_size; ++i)
+            if (parent(i) == parent_index)
+                return i;
+        return npos;
+    }
+
+    // indices out of the tree address the absent node
+    constexpr index_type node_or_npos(index_type index) const
+    {
+        return index < m_size ? index : npos;
+    }
+
+    // the first node of the subtree in post-order: the deepest first cause
+    index_type first_leaf(index_type index) const
+    {
+        if (node_or_npos(index) == npos)
+            return npos;
+        for (auto child = find_child(index, 0); child != npos;
+             child = find_child(index, 0))
+            index = child;
+        return index;
+    }
+
+    index_type next_in_postorder(index_type index, index_type subtree) const
+    {
+        if (index == subtree)
+            return npos;
+        auto const sibling
+            = find_child(parent(index), static_cast<index_type>(index + 1));
+        return sibling != npos ? first_leaf(sibling) : parent(index);
+    }
+
+    index_type next_in_preorder(index_type index, index_type subtree) const
+    {
+        // the old root gets a parent appended after it, hence the children
+        // are searched from the first node
+        auto const child = find_child(index, 0);
+        if (child != npos)
+            return child;
+        for (; index != subtree; index = parent(index)) {
+            auto const sibling
+                = find_child(parent(index), static_cast<index_type>(index + 1));
+            if (sibling != npos)
+                return sibling;
+        }
+        return npos;
+    }
+
+    result m_results[capacity]{};
+    uint64_t m_parents[parent_words]{};
+    uint64_t m_subtree_failures{};
+    index_type m_size{};
+    index_type m_root{};
+};
+
+template <typename Result, uint8_t Capacity>
+constexpr uint8_t error_tree_t<Result, Capacity>::capacity;
+
+template <typename Result, uint8_t Capacity>
+constexpr typename error_tree_t<Result, Capacity>::index_type
+    error_tree_t<Result, Capacity>::npos;
+
+template <typename Result, uint8_t Capacity>
+constexpr error_tree_t<Result, Capacity>
+    error_tree_t<Result, Capacity>::success;
+
+template <typename Result, uint8_t Capacity>
+constexpr bool is_success(error_tree_t<Result, Capacity> const &tree)
+{
+    return tree.root() == error_tree_t<Result, Capacity>::npos
+           || !tree.any_failure_under(tree.root());
+}
+
+}  // namespace respp
+
+#define MAKE_ERROR_TREE_TYPE(name, single_result, capacity) \
+    using name = ::respp::error_tree_t<single_result, capacity>
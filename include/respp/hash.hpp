@@ -0,0 +1,29 @@
+#pragma once
+
+#include "respp/result.hpp"
+
+#include <functional>
+
+// Results are hashed by the underlying value, so that they can be used as
+// keys of the standard unordered containers
+
+namespace std
+{
+template <typename Ut, typename... Cs>
+struct hash<respp::result_t<Ut, Cs...>> {
+    size_t operator()(respp::result_t<Ut, Cs...> const &r) const noexcept
+    {
+        return hash<Ut>{}(r.result);
+    }
+};
+
+template <typename Ut, typename Result, typename PlacementStrategy>
+struct hash<respp::aggregate_result_t<Ut, Result, PlacementStrategy>> {
+    size_t operator()(
+        respp::aggregate_result_t<Ut, Result, PlacementStrategy> const &r)
+        const noexcept
+    {
+        return hash<Ut>{}(r.container);
+    }
+};
+}  // namespace std
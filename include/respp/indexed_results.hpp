@@ -0,0 +1,272 @@
+#pragma once
+
+#include "respp/result.hpp"
+
+namespace respp
+{
+namespace detail
+{
+constexpr uint8_t bits_in_word = 64;
+
+// Bitmap with the summary levels above it: bit i of the upper level is set
+// when the word i of the lower level is not zero. find_next returns Bits
+// when no bit is found.
+template <size_t Bits, bool = (Bits > bits_in_word)>
+class hierarchical_bitmap;
+
+template <size_t Bits>
+class hierarchical_bitmap<Bits, false> {
+public:
+    bool any() const
+    {
+        return m_word != 0;
+    }
+
+    bool test(size_t index) const
+    {
+        return (m_word >> index) & 1;
+    }
+
+    void set(size_t index)
+    {
+        m_word |= uint64_t{1} << index;
+    }
+
+    void reset(size_t index)
+    {
+        m_word &= ~(uint64_t{1} << index);
+    }
+
+    size_t find_next(size_t from) const
+    {
+        if (from >= Bits)
+            return Bits;
+        auto const word = m_word & (~uint64_t{0} << from);
+        return word ? count_trailing_zeros(word) : Bits;
+    }
+
+private:
+    uint64_t m_word{};
+};
+
+template <size_t Bits>
+class hierarchical_bitmap<Bits, true> {
+public:
+    static constexpr size_t words = (Bits + bits_in_word - 1) / bits_in_word;
+
+    bool any() const
+    {
+        return m_upper.any();
+    }
+
+    bool test(size_t index) const
+    {
+        return (m_words[index / bits_in_word] >> (index % bits_in_word)) & 1;
+    }
+
+    void set(size_t index)
+    {
+        auto &word = m_words[index / bits_in_word];
+        if (!word)
+            m_upper.set(index / bits_in_word);
+        word |= uint64_t{1} << (index % bits_in_word);
+    }
+
+    void reset(size_t index)
+    {
+        auto &word = m_words[index / bits_in_word];
+        word &= ~(uint64_t{1} << (index % bits_in_word));
+        if (!word)
+            m_upper.reset(index / bits_in_word);
+    }
+
+    size_t find_next(size_t from) const
+    {
+        if (from >= Bits)
+            return Bits;
+        auto const word_index = from / bits_in_word;
+        auto const word
+            = m_words[word_index] & (~uint64_t{0} << (from % bits_in_word));
+        if (word)
+            return word_index * bits_in_word + count_trailing_zeros(word);
+
+        // the upper level skips the empty words
+        auto const next_word_index = m_upper.find_next(word_index + 1);
+        if (next_word_index == words)
+            return Bits;
+        return next_word_index * bits_in_word
+               + count_trailing_zeros(m_words[next_word_index]);
+    }
+
+private:
+    uint64_t m_words[words]{};
+    hierarchical_bitmap<words> m_upper;
+};
+
+// Sub-index of the failures per every value of the category
+template <size_t Size, typename C>
+struct category_index {
+    static_assert(
+        C::bit_width <= 8,
+        "Sub-index is kept for every category value, the category is too "
+        "wide");
+
+    hierarchical_bitmap<Size> by_value[1 << C::bit_width];
+};
+}  // namespace detail
+
+// Fixed size array of results indexing the entries that are not a success.
+// The index is updated on every write: the question whether there is any
+// failure is answered in O(1) and the failing entries are found by scanning
+// the non-empty words of the bitmap only. The failures can additionally be
+// indexed by the values of the selected categories.
+template <typename Result, size_t Size, typename... IndexedCategories>
+class indexed_results_t {
+public:
+    using result = Result;
+    using bitmap = detail::hierarchical_bitmap<Size>;
+
+    static constexpr size_t size = Size;
+    // index past the last entry returned when no failure is found
+    static constexpr size_t npos = Size;
+
+    class failure_iterator {
+    public:
+        failure_iterator() : m_bitmap(nullptr), m_index(npos)
+        {}
+
+        failure_iterator(bitmap const &failures)
+            : m_bitmap(&failures), m_index(failures.find_next(0))
+        {}
+
+        failure_iterator operator++()
+        {
+            m_index = m_bitmap->find_next(m_index + 1);
+            return *this;
+        }
+
+        failure_iterator operator++(int)
+        {
+            auto const previous_iterator(*this);
+            ++*this;
+            return previous_iterator;
+        }
+
+        // index of the failing entry
+        size_t operator*() const
+        {
+            return m_index;
+        }
+
+        friend bool operator==(
+            failure_iterator const &lhs, failure_iterator const &rhs)
+        {
+            return lhs.m_index == rhs.m_index;
+        }
+
+        friend bool operator!=(
+            failure_iterator const &lhs, failure_iterator const &rhs)
+        {
+            return lhs.m_index != rhs.m_index;
+        }
+
+    private:
+        bitmap const *m_bitmap;
+        size_t m_index;
+    };
+
+    result const &operator[](size_t const index) const
+    {
+        return m_results[index];
+    }
+
+    void set(size_t const index, result const &r)
+    {
+        auto const previous = m_results[index];
+        m_results[index] = r;
+
+        if (!(result::success == previous)) {
+            m_failures.reset(index);
+            --m_failure_count;
+            int const expand[] = {
+                0,
+                (by_category<IndexedCategories>(previous).reset(index), 0)...};
+            (void)expand;
+        }
+
+        if (!(result::success == r)) {
+            m_failures.set(index);
+            ++m_failure_count;
+            int const expand[]
+                = {0, (by_category<IndexedCategories>(r).set(index), 0)...};
+            (void)expand;
+        }
+    }
+
+    bool any_failure() const
+    {
+        return m_failures.any();
+    }
+
+    size_t failure_count() const
+    {
+        return m_failure_count;
+    }
+
+    // index of the first failure starting from the given one or npos
+    size_t find_next_failure(size_t const from) const
+    {
+        return m_failures.find_next(from);
+    }
+
+    iterator_pair<failure_iterator> iterate_failures() const
+    {
+        return make_iterator_pair(
+            failure_iterator(m_failures), failure_iterator{});
+    }
+
+    template <typename C>
+    bool any_failure(C const &category) const
+    {
+        return index_of(category).any();
+    }
+
+    template <typename C>
+    iterator_pair<failure_iterator> iterate_failures(C const &category) const
+    {
+        return make_iterator_pair(
+            failure_iterator(index_of(category)), failure_iterator{});
+    }
+
+private:
+    template <typename C>
+    bitmap &by_category(result const &r)
+    {
+        return static_cast<detail::category_index<Size, C> &>(m_categories)
+            .by_value[get_category<C>(r).value];
+    }
+
+    template <typename C>
+    bitmap const &index_of(C const &category) const
+    {
+        return static_cast<detail::category_index<Size, C> const &>(
+                   m_categories)
+            .by_value[category.value];
+    }
+
+    struct category_indexes
+        : detail::category_index<Size, IndexedCategories>... {};
+
+    result m_results[Size]{};
+    bitmap m_failures;
+    size_t m_failure_count{};
+    category_indexes m_categories;
+};
+
+template <typename Result, size_t Size, typename... IndexedCategories>
+constexpr size_t indexed_results_t<Result, Size, IndexedCategories...>::size;
+
+template <typename Result, size_t Size, typename... IndexedCategories>
+constexpr size_t indexed_results_t<Result, Size, IndexedCategories...>::npos;
+
+}  // namespace respp
@@ -0,0 +1,525 @@
+#pragma once
+
+#include "respp/result.hpp"
+
+#include <initializer_list>
+
+namespace respp
+{
+// Building blocks of result predicates. The expressions are combined with
+// &&, || and ! and are compiled for the concrete result type via
+// respp::compile_predicate.
+namespace predicates
+{
+// pseudo-field addressing the code bits of the result
+struct code_field {};
+
+template <typename Field, size_t N>
+struct field_test {
+    uint64_t values[N];
+};
+
+template <typename Expr>
+struct not_t {
+    Expr expr;
+};
+
+template <typename Lhs, typename Rhs>
+struct and_t {
+    Lhs lhs;
+    Rhs rhs;
+};
+
+template <typename Lhs, typename Rhs>
+struct or_t {
+    Lhs lhs;
+    Rhs rhs;
+};
+
+template <typename T>
+struct is_predicate : std::false_type {};
+
+template <typename Field, size_t N>
+struct is_predicate<field_test<Field, N>> : std::true_type {};
+
+template <typename Expr>
+struct is_predicate<not_t<Expr>> : std::true_type {};
+
+template <typename Lhs, typename Rhs>
+struct is_predicate<and_t<Lhs, Rhs>> : std::true_type {};
+
+template <typename Lhs, typename Rhs>
+struct is_predicate<or_t<Lhs, Rhs>> : std::true_type {};
+
+namespace detail
+{
+constexpr bool all_of(std::initializer_list<bool> values)
+{
+    for (auto const v : values)
+        if (!v)
+            return false;
+    return true;
+}
+}  // namespace detail
+
+template <typename Token, uint8_t BitWidth>
+constexpr field_test<category_t<Token, BitWidth>, 1> is(
+    category_t<Token, BitWidth> const &category)
+{
+    return {{category.value}};
+}
+
+template <typename Token, uint8_t BitWidth, typename... Cs>
+constexpr field_test<category_t<Token, BitWidth>, 1 + sizeof...(Cs)> is_any_of(
+    category_t<Token, BitWidth> const &category, Cs const &...categories)
+{
+    static_assert(
+        detail::all_of(
+            {std::is_same<category_t<Token, BitWidth>, Cs>::value...}),
+        "All the categories should be of the same type");
+    return {{category.value, categories.value...}};
+}
+
+constexpr field_test<code_field, 1> has_code(uint64_t code)
+{
+    return {{code}};
+}
+
+template <typename... Codes>
+constexpr field_test<code_field, 1 + sizeof...(Codes)> has_any_code(
+    uint64_t code, Codes... codes)
+{
+    return {{code, static_cast<uint64_t>(codes)...}};
+}
+
+template <
+    typename Expr,
+    typename = std::enable_if_t<is_predicate<Expr>::value>>
+constexpr not_t<Expr> operator!(Expr const &expr)
+{
+    return {expr};
+}
+
+template <
+    typename Lhs,
+    typename Rhs,
+    typename = std::enable_if_t<
+        is_predicate<Lhs>::value && is_predicate<Rhs>::value>>
+constexpr and_t<Lhs, Rhs> operator&&(Lhs const &lhs, Rhs const &rhs)
+{
+    return {lhs, rhs};
+}
+
+template <
+    typename Lhs,
+    typename Rhs,
+    typename = std::enable_if_t<
+        is_predicate<Lhs>::value && is_predicate<Rhs>::value>>
+constexpr or_t<Lhs, Rhs> operator||(Lhs const &lhs, Rhs const &rhs)
+{
+    return {lhs, rhs};
+}
+
+}  // namespace predicates
+
+namespace detail
+{
+constexpr size_t non_zero(size_t n)
+{
+    return n ? n : 1;
+}
+
+// Disjunctive normal form size bounds of the (possibly negated) expression:
+// the number of terms and the number of negative comparisons per term
+template <size_t Terms, size_t Negatives>
+struct dnf_size_t {
+    static constexpr size_t terms = Terms;
+    static constexpr size_t negatives = Negatives;
+};
+
+template <typename A, typename B>
+using dnf_product
+    = dnf_size_t<A::terms * B::terms, A::negatives + B::negatives>;
+
+template <typename A, typename B>
+using dnf_union = dnf_size_t<
+    A::terms + B::terms,
+    (A::negatives > B::negatives) ? A::negatives : B::negatives>;
+
+template <typename Expr, bool Negated>
+struct dnf_size;
+
+template <typename Field, size_t N>
+struct dnf_size<predicates::field_test<Field, N>, false> : dnf_size_t<N, 0> {};
+
+template <typename Field, size_t N>
+struct dnf_size<predicates::field_test<Field, N>, true> : dnf_size_t<1, N> {};
+
+template <typename Expr, bool Negated>
+struct dnf_size<predicates::not_t<Expr>, Negated>
+    : dnf_size<Expr, !Negated> {};
+
+template <typename Lhs, typename Rhs>
+struct dnf_size<predicates::and_t<Lhs, Rhs>, false>
+    : dnf_product<dnf_size<Lhs, false>, dnf_size<Rhs, false>> {};
+
+template <typename Lhs, typename Rhs>
+struct dnf_size<predicates::and_t<Lhs, Rhs>, true>
+    : dnf_union<dnf_size<Lhs, true>, dnf_size<Rhs, true>> {};
+
+template <typename Lhs, typename Rhs>
+struct dnf_size<predicates::or_t<Lhs, Rhs>, false>
+    : dnf_union<dnf_size<Lhs, false>, dnf_size<Rhs, false>> {};
+
+template <typename Lhs, typename Rhs>
+struct dnf_size<predicates::or_t<Lhs, Rhs>, true>
+    : dnf_product<dnf_size<Lhs, true>, dnf_size<Rhs, true>> {};
+
+// Position of the field bits in the concrete result type
+template <typename Field, typename Result>
+struct field_layout;
+
+template <typename C, typename Ut, typename... Cs>
+struct field_layout<C, result_t<Ut, Cs...>> {
+    static constexpr int bits_offset = count_bits_before<C, Cs...>::value;
+    static_assert(bits_offset >= 0, "The category is not found");
+
+    static constexpr auto offset_from_the_lsb
+        = sizeof_in_bits_v<Ut> - bits_offset - C::bit_width;
+
+    static constexpr Ut mask()
+    {
+        return static_cast<Ut>(
+            ~detail::mask<Ut, offset_from_the_lsb, C::bit_width>);
+    }
+
+    static constexpr bool fits(uint64_t value)
+    {
+        return !(value >> C::bit_width);
+    }
+
+    static constexpr Ut place(uint64_t value)
+    {
+        return static_cast<Ut>(mask() & (value << offset_from_the_lsb));
+    }
+};
+
+template <typename Ut, typename... Cs>
+struct field_layout<predicates::code_field, result_t<Ut, Cs...>> {
+    static constexpr auto bits_for_code
+        = sizeof_in_bits_v<Ut> - sum_widths<Cs...>();
+
+    static constexpr Ut mask()
+    {
+        return static_cast<Ut>(~detail::mask<Ut, 0, bits_for_code>);
+    }
+
+    static constexpr bool fits(uint64_t value)
+    {
+        return bits_for_code >= 64 || !(value >> bits_for_code);
+    }
+
+    static constexpr Ut place(uint64_t value)
+    {
+        return static_cast<Ut>(mask() & value);
+    }
+};
+
+// Conjunction of the positive comparison (r & mask) == value and of the
+// negative comparisons (r & negative_masks[i]) != negative_values[i]
+template <typename Ut, size_t Negatives>
+struct match_term {
+    Ut mask{};
+    Ut value{};
+    size_t negative_count{};
+    Ut negative_masks[non_zero(Negatives)]{};
+    Ut negative_values[non_zero(Negatives)]{};
+
+    constexpr bool matches(Ut r) const
+    {
+        if ((r & mask) != value)
+            return false;
+        for (size_t i = 0; i < negative_count; ++i)
+            if ((r & negative_masks[i]) == negative_values[i])
+                return false;
+        return true;
+    }
+
+    // returns false if the term can not be satisfied anymore
+    constexpr bool add_positive(Ut m, Ut v)
+    {
+        if ((value ^ v) & mask & m)
+            return false;
+        mask = static_cast<Ut>(mask | m);
+        value = static_cast<Ut>(value | v);
+        return true;
+    }
+
+    // returns false if the term can not be satisfied anymore, the
+    // comparisons decided by the positive part are not stored
+    constexpr bool add_negative(Ut m, Ut v)
+    {
+        if ((m & mask) == m)
+            return (value & m) != v;
+        for (size_t i = 0; i < negative_count; ++i)
+            if (negative_masks[i] == m && negative_values[i] == v)
+                return true;
+        negative_masks[negative_count] = m;
+        negative_values[negative_count] = v;
+        ++negative_count;
+        return true;
+    }
+
+    friend constexpr bool operator==(
+        match_term const &lhs, match_term const &rhs)
+    {
+        if (lhs.mask != rhs.mask || lhs.value != rhs.value
+            || lhs.negative_count != rhs.negative_count)
+            return false;
+        for (size_t i = 0; i < lhs.negative_count; ++i)
+            if (lhs.negative_masks[i] != rhs.negative_masks[i]
+                || lhs.negative_values[i] != rhs.negative_values[i])
+                return false;
+        return true;
+    }
+};
+
+template <typename Ut, size_t Terms, size_t Negatives>
+struct match_dnf {
+    using term = match_term<Ut, Negatives>;
+
+    size_t term_count{};
+    term terms[non_zero(Terms)]{};
+
+    constexpr void add(term const &t)
+    {
+        for (size_t i = 0; i < term_count; ++i)
+            if (terms[i] == t)
+                return;
+        terms[term_count++] = t;
+    }
+};
+
+template <typename Dnf>
+constexpr Dnf dnf_or(Dnf const &lhs, Dnf const &rhs)
+{
+    auto result = lhs;
+    for (size_t i = 0; i < rhs.term_count; ++i)
+        result.add(rhs.terms[i]);
+    return result;
+}
+
+template <typename Term>
+constexpr bool add_negatives(Term &to, Term const &from)
+{
+    for (size_t i = 0; i < from.negative_count; ++i)
+        if (!to.add_negative(from.negative_masks[i], from.negative_values[i]))
+            return false;
+    return true;
+}
+
+template <typename Dnf>
+constexpr Dnf dnf_and(Dnf const &lhs, Dnf const &rhs)
+{
+    Dnf result{};
+    for (size_t i = 0; i < lhs.term_count; ++i) {
+        for (size_t j = 0; j < rhs.term_count; ++j) {
+            auto const &l = lhs.terms[i];
+            auto const &r = rhs.terms[j];
+            // positive parts go first to decide as many negatives as possible
+            typename Dnf::term t{};
+            if (t.add_positive(l.mask, l.value)
+                && t.add_positive(r.mask, r.value) && add_negatives(t, l)
+                && add_negatives(t, r))
+                result.add(t);
+        }
+    }
+    return result;
+}
+
+// Builds the disjunctive normal form of the expression, negation is pushed
+// down to the field tests by De Morgan's laws
+template <typename Result, typename Dnf>
+struct dnf_builder {
+    template <typename Field, size_t N>
+    static constexpr Dnf build(
+        predicates::field_test<Field, N> const &expr, bool negated)
+    {
+        using layout = field_layout<Field, Result>;
+        Dnf result{};
+        typename Dnf::term t{};
+        for (size_t i = 0; i < N; ++i) {
+            // the value out of the field range never equals the field, the
+            // constant predicate with it fails to compile
+            if (!layout::fits(expr.values[i])) {
+                fail_constant_evaluation();
+                continue;
+            }
+            auto const value = layout::place(expr.values[i]);
+            if (negated) {
+                if (!t.add_negative(layout::mask(), value))
+                    return result;
+            } else {
+                typename Dnf::term single{};
+                single.add_positive(layout::mask(), value);
+                result.add(single);
+            }
+        }
+        if (negated)
+            result.add(t);
+        return result;
+    }
+
+    template <typename Expr>
+    static constexpr Dnf build(
+        predicates::not_t<Expr> const &expr, bool negated)
+    {
+        return build(expr.expr, !negated);
+    }
+
+    template <typename Lhs, typename Rhs>
+    static constexpr Dnf build(
+        predicates::and_t<Lhs, Rhs> const &expr, bool negated)
+    {
+        auto const lhs = build(expr.lhs, negated);
+        auto const rhs = build(expr.rhs, negated);
+        return negated ? dnf_or(lhs, rhs) : dnf_and(lhs, rhs);
+    }
+
+    template <typename Lhs, typename Rhs>
+    static constexpr Dnf build(
+        predicates::or_t<Lhs, Rhs> const &expr, bool negated)
+    {
+        auto const lhs = build(expr.lhs, negated);
+        auto const rhs = build(expr.rhs, negated);
+        return negated ? dnf_and(lhs, rhs) : dnf_or(lhs, rhs);
+    }
+};
+
+}  // namespace detail
+
+// Predicate compiled for the result type to the list of (mask, value)
+// comparisons of the result bits. Tests single results, the slots of
+// aggregate results and filters arrays of results.
+template <typename Result, size_t Terms, size_t Negatives>
+class compiled_predicate {
+public:
+    using result = Result;
+    using underlaying_type = typename result::underlaying_type;
+    using dnf = detail::match_dnf<underlaying_type, Terms, Negatives>;
+
+    static constexpr uint8_t result_bits
+        = detail::sizeof_in_bits_v<underlaying_type>;
+
+    constexpr explicit compiled_predicate(dnf const &d) : m_dnf(d)
+    {}
+
+    // number of (mask, value) terms left after the simplification
+    constexpr size_t term_count() const
+    {
+        return m_dnf.term_count;
+    }
+
+    constexpr bool operator()(result const &r) const
+    {
+        for (size_t i = 0; i < m_dnf.term_count; ++i)
+            if (m_dnf.terms[i].matches(r.result))
+                return true;
+        return false;
+    }
+
+    // Bit i of the returned value is set when the predicate holds for the
+    // slot i. Only the slots visited by iterate_errors are considered.
+    template <typename Ut, typename PlacementStrategy>
+    constexpr uint8_t matching_slots(
+        aggregate_result_t<Ut, result, PlacementStrategy> const &r) const
+    {
+        auto const flags = match_flags(r.container);
+        uint8_t slots{};
+        auto occupied = r.container;
+        for (auto i = 0; occupied != 0; ++i) {
+            if ((flags >> (i * result_bits + result_bits - 1)) & 1)
+                slots = static_cast<uint8_t>(slots | (1 << i));
+            occupied = static_cast<Ut>(occupied >> result_bits);
+        }
+        return slots;
+    }
+
+    template <typename Ut, typename PlacementStrategy>
+    constexpr bool any_slot(
+        aggregate_result_t<Ut, result, PlacementStrategy> const &r) const
+    {
+        return matching_slots(r) != 0;
+    }
+
+    // Copies the results satisfying the predicate to out and returns the
+    // end of the copied range. Several results are tested at once.
+    result *filter(result const *first, result const *last, result *out) const
+    {
+        constexpr ptrdiff_t per_word = sizeof(uint64_t) / sizeof(result);
+        while (last - first >= per_word) {
+            uint64_t word{};
+            for (auto i = 0; i < per_word; ++i)
+                word |= static_cast<uint64_t>(first[i].result)
+                        << (i * result_bits);
+
+            auto const flags = match_flags(word);
+            for (auto i = 0; i < per_word; ++i)
+                if ((flags >> (i * result_bits + result_bits - 1)) & 1)
+                    *out++ = first[i];
+            first += per_word;
+        }
+
+        for (; first != last; ++first)
+            if ((*this)(*first))
+                *out++ = *first;
+        return out;
+    }
+
+private:
+    // sets the most significant bit of every slot of the word that
+    // satisfies the predicate
+    template <typename Word>
+    constexpr Word match_flags(Word word) const
+    {
+        using swar = detail::swar<Word, result_bits>;
+        Word flags{};
+        for (size_t i = 0; i < m_dnf.term_count; ++i) {
+            auto const &t = m_dnf.terms[i];
+            auto term_flags = swar::zero_slots(static_cast<Word>(
+                (word & swar::broadcast(t.mask)) ^ swar::broadcast(t.value)));
+            for (size_t k = 0; k < t.negative_count; ++k)
+                term_flags &= static_cast<Word>(~swar::zero_slots(
+                    static_cast<Word>(
+                        (word & swar::broadcast(t.negative_masks[k]))
+                        ^ swar::broadcast(t.negative_values[k]))));
+            flags |= term_flags;
+        }
+        return flags;
+    }
+
+    dnf m_dnf;
+};
+
+template <typename Result, size_t Terms, size_t Negatives>
+constexpr uint8_t compiled_predicate<Result, Terms, Negatives>::result_bits;
+
+template <typename Result, typename Expr>
+constexpr compiled_predicate<
+    Result,
+    detail::dnf_size<Expr, false>::terms,
+    detail::dnf_size<Expr, false>::negatives>
+compile_predicate(Expr const &expr)
+{
+    static_assert(
+        predicates::is_predicate<Expr>::value,
+        "The expression should be built from respp::predicates");
+    using size = detail::dnf_size<Expr, false>;
+    using predicate
+        = compiled_predicate<Result, size::terms, size::negatives>;
+    return predicate(
+        detail::dnf_builder<Result, typename predicate::dnf>::build(
+            expr, false));
+}
+
+}  // namespace respp
@@ -46,6 +46,13 @@ constexpr T generate_mask(uint8_t const offset, uint8_t const length)
 {
     // prefix  length  offset
     // 1111    00      11
+#if defined(RESPP_OPTIMIZE_FOR_SIZE)
+    if (!length)
+        return static_cast<T>(~T{});
+    auto const ones = static_cast<T>(~T{});
+    return static_cast<T>(
+        ~(static_cast<T>(ones >> (sizeof_in_bits_v<T> - length)) << offset));
+#else
     const auto prefix_length = sizeof_in_bits_v<T> - length - offset;
     T mask{};
     for (auto i = 0; i < prefix_length; ++i)
@@ -57,11 +64,84 @@ constexpr T generate_mask(uint8_t const offset, uint8_t const length)
         mask = (mask << 1) + 1;
 
     return mask;
+#endif
 }
 
 template <typename T, uint8_t offset, uint8_t length>
 constexpr T mask = generate_mask<T>(offset, length);
 
+// SIMD-within-a-register helpers treating Word as a row of SlotBits-wide
+// slots (e.g. the slots of an aggregate result container)
+template <typename Word, uint8_t SlotBits>
+struct swar {
+    static constexpr Word lsb_ones()
+    {
+        Word ones{};
+        for (auto i = 0; i < sizeof_in_bits_v<Word> / SlotBits; ++i)
+            ones = static_cast<Word>((ones << (SlotBits - 1) << 1) | 1);
+        return ones;
+    }
+
+    static constexpr Word msb_ones()
+    {
+        return static_cast<Word>(lsb_ones() << (SlotBits - 1));
+    }
+
+    // copies the slot value into every slot of the word
+    static constexpr Word broadcast(Word slot)
+    {
+        return static_cast<Word>(slot * lsb_ones());
+    }
+
+    // sets the most significant bit of every zero slot, clears other bits
+    static constexpr Word zero_slots(Word x)
+    {
+        constexpr Word low = static_cast<Word>(~msb_ones());
+        return static_cast<Word>(
+            ~(static_cast<Word>((x & low) + low) | x | low));
+    }
+};
+
+// number of bits required to represent the value
+constexpr uint8_t bit_width(uint64_t value)
+{
+    uint8_t width = 0;
+    for (; value; value >>= 1)
+        ++width;
+    return width;
+}
+
+// Fibonacci hashing: the top bits of the product are well mixed, index_bits
+// should be in 1..63
+constexpr size_t fibonacci_hash(uint64_t value, uint8_t index_bits)
+{
+    return static_cast<size_t>(
+        (value * 0x9E3779B97F4A7C15ull) >> (64 - index_bits));
+}
+
+// x should not be zero. Words up to 32 bits use the single word instruction,
+// which on 32-bit targets avoids the two word sequence or the library call.
+template <typename T>
+constexpr uint8_t count_trailing_zeros(T x)
+{
+#if defined(__GNUC__)
+    return static_cast<uint8_t>(
+        sizeof(T) <= sizeof(unsigned)
+            ? __builtin_ctz(static_cast<unsigned>(x))
+            : __builtin_ctzll(static_cast<unsigned long long>(x)));
+#else
+    uint8_t count = 0;
+    for (; !(x & 1); x >>= 1)
+        ++count;
+    return count;
+#endif
+}
+
+// Not constexpr: the constant evaluation reaching the call fails to compile.
+// Rejects the invalid input of the functions evaluated at compile time.
+inline void fail_constant_evaluation()
+{}
+
 template <typename C1>
 constexpr uint8_t sum_widths()
 {
@@ -179,6 +259,17 @@ struct place_while_space_is_available {
     static constexpr void place_result(Ut &container, Result const &r)
     {
         using result_underlaying_type = typename Result::underlaying_type;
+#if defined(RESPP_OPTIMIZE_FOR_SIZE)
+        // the lowest flag marks the first empty slot
+        constexpr auto slot_bits = sizeof_in_bits_v<result_underlaying_type>;
+        auto const empty_slots = swar<Ut, slot_bits>::zero_slots(container);
+        if (empty_slots) {
+            auto const shift_in_bits
+                = count_trailing_zeros(empty_slots) - (slot_bits - 1);
+            container |= static_cast<Ut>(
+                static_cast<Ut>(r.result) << shift_in_bits);
+        }
+#else
         constexpr uint8_t capacity
             = sizeof(Ut) / sizeof(result_underlaying_type);
         for (auto shift_value = 0; shift_value < capacity; ++shift_value) {
@@ -192,6 +283,7 @@ struct place_while_space_is_available {
                 break;
             }
         }
+#endif
     }
 };
 
@@ -200,6 +292,22 @@ struct replace_topmost {
     static constexpr void place_result(Ut &container, Result const &r)
     {
         using result_underlaying_type = typename Result::underlaying_type;
+#if defined(RESPP_OPTIMIZE_FOR_SIZE)
+        // the topmost slot is flagged to be replaced when no slot is empty
+        constexpr auto slot_bits = sizeof_in_bits_v<result_underlaying_type>;
+        constexpr auto topmost_slot_flag
+            = static_cast<Ut>(Ut{1} << (sizeof_in_bits_v<Ut> - 1));
+        constexpr auto slot_mask
+            = static_cast<Ut>(static_cast<result_underlaying_type>(~Ut{}));
+        auto const empty_slots = static_cast<Ut>(
+            swar<Ut, slot_bits>::zero_slots(container) | topmost_slot_flag);
+        auto const shift_in_bits
+            = count_trailing_zeros(empty_slots) - (slot_bits - 1);
+
+        container &= static_cast<Ut>(~(slot_mask << shift_in_bits));
+        container |= static_cast<Ut>(
+            static_cast<Ut>(r.result) << shift_in_bits);
+#else
         constexpr uint8_t capacity
             = sizeof(Ut) / sizeof(result_underlaying_type);
         auto shift_value = 0;
@@ -219,6 +327,7 @@ struct replace_topmost {
         container &= detail::generate_mask<Ut>(
             shift_in_bits, detail::sizeof_in_bits_v<result_underlaying_type>);
         container |= (r.result << shift_in_bits);
+#endif
     }
 };
 
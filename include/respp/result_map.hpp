@@ -0,0 +1,297 @@
+#pragma once
+
+#include "respp/result.hpp"
+
+#include <initializer_list>
+#include <utility>
+
+namespace respp
+{
+namespace detail
+{
+// Value per every value of the result, occupied slots are marked in the bitmap
+template <typename Ut, typename Value>
+class direct_result_slots {
+public:
+    constexpr Value *find(Ut const key)
+    {
+        return occupied(key) ? &m_values[key] : nullptr;
+    }
+
+    constexpr Value const *find(Ut const key) const
+    {
+        return occupied(key) ? &m_values[key] : nullptr;
+    }
+
+    constexpr Value *insert(Ut const key, Value const &value)
+    {
+        if (!occupied(key)) {
+            m_occupied[key / 64] |= uint64_t{1} << (key % 64);
+            m_values[key] = value;
+            ++m_size;
+        }
+        return &m_values[key];
+    }
+
+    constexpr bool erase(Ut const key)
+    {
+        if (!occupied(key))
+            return false;
+        m_occupied[key / 64] &= ~(uint64_t{1} << (key % 64));
+        m_values[key] = Value{};
+        --m_size;
+        return true;
+    }
+
+    constexpr size_t size() const
+    {
+        return m_size;
+    }
+
+    constexpr bool overflowed() const
+    {
+        return false;
+    }
+
+    template <typename F>
+    constexpr void for_each(F &&f)
+    {
+        for (size_t i = 0; i < words; ++i) {
+            for (auto word = m_occupied[i]; word; word &= word - 1) {
+                auto const key = static_cast<Ut>(
+                    i * 64 + count_trailing_zeros(word));
+                f(key, m_values[key]);
+            }
+        }
+    }
+
+private:
+    static constexpr size_t slots = size_t{1} << sizeof_in_bits_v<Ut>;
+    static constexpr size_t words = slots / 64;
+
+    constexpr bool occupied(Ut const key) const
+    {
+        return (m_occupied[key / 64] >> (key % 64)) & 1;
+    }
+
+    uint64_t m_occupied[words]{};
+    Value m_values[slots]{};
+    size_t m_size{};
+};
+
+// Open addressing with linear probing, zero (success) marks the empty slot.
+// Erase shifts the following entries of the probe sequence back instead of
+// leaving tombstones, so lookups stop at the first empty slot.
+template <typename Ut, typename Value, size_t Capacity>
+class hashed_result_slots {
+public:
+    static_assert(
+        Capacity >= 2 && !(Capacity & (Capacity - 1)),
+        "The capacity of the hashed map should be a power of two");
+
+    constexpr Value *find(Ut const key)
+    {
+        auto const slot = find_slot(key);
+        return slot != npos ? &m_values[slot] : nullptr;
+    }
+
+    constexpr Value const *find(Ut const key) const
+    {
+        auto const slot = find_slot(key);
+        return slot != npos ? &m_values[slot] : nullptr;
+    }
+
+    // returns nullptr if there is no space left for the key
+    constexpr Value *insert(Ut const key, Value const &value)
+    {
+        for (size_t i = 0, slot = home_slot(key); i < Capacity;
+             ++i, slot = next(slot)) {
+            if (m_keys[slot] == key)
+                return &m_values[slot];
+            if (!m_keys[slot]) {
+                m_keys[slot] = key;
+                m_values[slot] = value;
+                ++m_size;
+                return &m_values[slot];
+            }
+        }
+        m_overflowed = true;
+        return nullptr;
+    }
+
+    constexpr bool erase(Ut const key)
+    {
+        auto hole = find_slot(key);
+        if (hole == npos)
+            return false;
+
+        m_keys[hole] = 0;
+        for (auto slot = next(hole); m_keys[slot]; slot = next(slot)) {
+            // the entry may fill the hole if it lies between its home slot
+            // and the entry itself
+            if (distance(home_slot(m_keys[slot]), slot)
+                >= distance(hole, slot)) {
+                m_keys[hole] = m_keys[slot];
+                m_values[hole] = std::move(m_values[slot]);
+                m_keys[slot] = 0;
+                hole = slot;
+            }
+        }
+        m_values[hole] = Value{};
+        --m_size;
+        return true;
+    }
+
+    constexpr size_t size() const
+    {
+        return m_size;
+    }
+
+    // set when a key was dropped for the lack of space
+    constexpr bool overflowed() const
+    {
+        return m_overflowed;
+    }
+
+    template <typename F>
+    constexpr void for_each(F &&f)
+    {
+        for (size_t slot = 0; slot < Capacity; ++slot) {
+            if (m_keys[slot])
+                f(m_keys[slot], m_values[slot]);
+        }
+    }
+
+private:
+    static constexpr size_t npos = Capacity;
+
+    static constexpr size_t home_slot(Ut const key)
+    {
+        return fibonacci_hash(key, bit_width(Capacity - 1));
+    }
+
+    static constexpr size_t next(size_t const slot)
+    {
+        return (slot + 1) & (Capacity - 1);
+    }
+
+    static constexpr size_t distance(size_t const from, size_t const to)
+    {
+        return (to - from) & (Capacity - 1);
+    }
+
+    constexpr size_t find_slot(Ut const key) const
+    {
+        for (size_t i = 0, slot = home_slot(key); i < Capacity;
+             ++i, slot = next(slot)) {
+            if (m_keys[slot] == key)
+                return slot;
+            if (!m_keys[slot])
+                return npos;
+        }
+        return npos;
+    }
+
+    Ut m_keys[Capacity]{};
+    Value m_values[Capacity]{};
+    size_t m_size{};
+    bool m_overflowed{};
+};
+}  // namespace detail
+
+// Flat map from the error to the per error state (retry budgets, counters),
+// without allocations. Success is used as the empty key and can not be
+// inserted. Results with 8 bit underlying type, or 16 bit when Capacity covers
+// the whole value space, are indexed directly, wider ones are hashed into the
+// table of Capacity entries. Value should be default constructible.
+// Entries not fitting the table (or success keys) make the constant
+// initialization of the map fail to compile, at runtime the map is marked as
+// overflowed.
+template <typename Result, typename Value, size_t Capacity = 64>
+class result_map {
+public:
+    using result = Result;
+    using underlaying_type = typename result::underlaying_type;
+    using mapped_type = Value;
+
+    static constexpr bool is_direct
+        = sizeof(underlaying_type) == 1
+          || (sizeof(underlaying_type) == 2 && Capacity >= (size_t{1} << 16));
+
+    constexpr result_map() = default;
+
+    constexpr result_map(std::initializer_list<std::pair<result, Value>> values)
+    {
+        for (auto const &value : values) {
+            if (!insert(value.first, value.second))
+                detail::fail_constant_evaluation();
+        }
+    }
+
+    constexpr Value *find(result const &r)
+    {
+        return respp::is_success(r) ? nullptr : m_storage.find(r.result);
+    }
+
+    constexpr Value const *find(result const &r) const
+    {
+        return respp::is_success(r) ? nullptr : m_storage.find(r.result);
+    }
+
+    constexpr bool contains(result const &r) const
+    {
+        return find(r) != nullptr;
+    }
+
+    // Returns the stored value, the existing one is kept. Returns nullptr for
+    // success or if there is no space left in the hashed table.
+    constexpr Value *insert(result const &r, Value const &value = Value{})
+    {
+        return respp::is_success(r) ? nullptr
+                                    : m_storage.insert(r.result, value);
+    }
+
+    constexpr bool erase(result const &r)
+    {
+        return !respp::is_success(r) && m_storage.erase(r.result);
+    }
+
+    constexpr size_t size() const
+    {
+        return m_storage.size();
+    }
+
+    constexpr bool empty() const
+    {
+        return !size();
+    }
+
+    // some of the inserted entries were dropped for the lack of space
+    constexpr bool overflowed() const
+    {
+        return m_storage.overflowed();
+    }
+
+    // calls f(result, value &) for every entry
+    template <typename F>
+    void for_each(F &&f)
+    {
+        m_storage.for_each(
+            [&f](underlaying_type const key, Value &value) {
+                f(result{key}, value);
+            });
+    }
+
+private:
+    using storage = std::conditional_t<
+        is_direct,
+        detail::direct_result_slots<underlaying_type, Value>,
+        detail::hashed_result_slots<underlaying_type, Value, Capacity>>;
+
+    storage m_storage{};
+};
+
+template <typename Result, typename Value, size_t Capacity>
+constexpr bool result_map<Result, Value, Capacity>::is_direct;
+
+}  // namespace respp
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "respp/result.hpp"
+
+#include <initializer_list>
+
+namespace respp
+{
+namespace detail
+{
+// Bit per every value of the 8 or 16 bit result
+template <typename Ut>
+class direct_result_bitmap {
+public:
+    constexpr bool insert(Ut const value)
+    {
+        m_words[value / 64] |= uint64_t{1} << (value % 64);
+        return true;
+    }
+
+    constexpr bool contains(Ut const value) const
+    {
+        return (m_words[value / 64] >> (value % 64)) & 1;
+    }
+
+    constexpr bool overflowed() const
+    {
+        return false;
+    }
+
+    constexpr bool unite(direct_result_bitmap const &other)
+    {
+        for (size_t i = 0; i < words; ++i)
+            m_words[i] |= other.m_words[i];
+        return true;
+    }
+
+    constexpr void intersect(direct_result_bitmap const &other)
+    {
+        for (size_t i = 0; i < words; ++i)
+            m_words[i] &= other.m_words[i];
+    }
+
+private:
+    static constexpr size_t words = (size_t{1} << sizeof_in_bits_v<Ut>) / 64;
+
+    uint64_t m_words[words]{};
+};
+
+// Open addressing table with linear probing for the wider results, success
+// (zero) marks the empty slot and is tracked separately
+template <typename Ut, size_t Capacity>
+class hashed_result_table {
+public:
+    static_assert(
+        Capacity >= 2 && !(Capacity & (Capacity - 1)),
+        "The capacity of the hashed set should be a power of two");
+
+    // returns false if there is no space left for the value
+    constexpr bool insert(Ut const value)
+    {
+        if (!value) {
+            m_contains_success = true;
+            return true;
+        }
+        for (size_t i = 0, slot = home_slot(value); i < Capacity;
+             ++i, slot = (slot + 1) % Capacity) {
+            if (m_slots[slot] == value)
+                return true;
+            if (!m_slots[slot]) {
+                m_slots[slot] = value;
+                return true;
+            }
+        }
+        m_overflowed = true;
+        return false;
+    }
+
+    constexpr bool contains(Ut const value) const
+    {
+        if (!value)
+            return m_contains_success;
+        for (size_t i = 0, slot = home_slot(value); i < Capacity;
+             ++i, slot = (slot + 1) % Capacity) {
+            if (m_slots[slot] == value)
+                return true;
+            if (!m_slots[slot])
+                return false;
+        }
+        return false;
+    }
+
+    // set when a value was dropped for the lack of space
+    constexpr bool overflowed() const
+    {
+        return m_overflowed;
+    }
+
+    // returns false if some of the values did not fit
+    constexpr bool unite(hashed_result_table const &other)
+    {
+        m_contains_success = m_contains_success || other.m_contains_success;
+        m_overflowed = m_overflowed || other.m_overflowed;
+        auto fits = true;
+        for (auto const value : other.m_slots)
+            if (value && !insert(value))
+                fits = false;
+        return fits;
+    }
+
+    constexpr void intersect(hashed_result_table const &other)
+    {
+        hashed_result_table result{};
+        result.m_contains_success
+            = m_contains_success && other.m_contains_success;
+        // the dropped values could have been common
+        result.m_overflowed = m_overflowed || other.m_overflowed;
+        for (auto const value : m_slots)
+            if (value && other.contains(value))
+                result.insert(value);
+        *this = result;
+    }
+
+private:
+    static constexpr size_t home_slot(Ut const value)
+    {
+        return fibonacci_hash(value, bit_width(Capacity - 1));
+    }
+
+    Ut m_slots[Capacity]{};
+    bool m_contains_success{};
+    bool m_overflowed{};
+};
+}  // namespace detail
+
+// Constant time membership test of the results. Results with 8 or 16 bit
+// underlying type are kept in the bitmap over the whole value space (32 bytes
+// and 8 KiB), wider ones in the hashed table of HashedCapacity entries.
+// Results not fitting the table make the constant initialization of the set
+// fail to compile, at runtime the set is marked as overflowed.
+template <typename Result, size_t HashedCapacity = 64>
+class result_set {
+public:
+    using result = Result;
+    using underlaying_type = typename result::underlaying_type;
+
+    static constexpr bool is_direct = sizeof(underlaying_type) <= 2;
+
+    constexpr result_set() = default;
+
+    constexpr result_set(std::initializer_list<result> results)
+    {
+        for (auto const &r : results) {
+            if (!insert(r))
+                detail::fail_constant_evaluation();
+        }
+    }
+
+    // returns false if there is no space left in the hashed table
+    constexpr bool insert(result const &r)
+    {
+        return m_storage.insert(r.result);
+    }
+
+    // some of the inserted results were dropped for the lack of space
+    constexpr bool overflowed() const
+    {
+        return m_storage.overflowed();
+    }
+
+    constexpr bool contains(result const &r) const
+    {
+        return m_storage.contains(r.result);
+    }
+
+    // any of the errors of the aggregate result is in the set
+    template <typename Ut, typename PlacementStrategy>
+    constexpr bool contains_any(
+        aggregate_result_t<Ut, result, PlacementStrategy> const &r) const
+    {
+        for (auto container = r.container; container;
+             container = static_cast<Ut>(
+                 container >> detail::sizeof_in_bits_v<underlaying_type>)) {
+            if (m_storage.contains(static_cast<underlaying_type>(container)))
+                return true;
+        }
+        return false;
+    }
+
+    friend constexpr result_set operator|(
+        result_set const &lhs, result_set const &rhs)
+    {
+        auto set = lhs;
+        if (!set.m_storage.unite(rhs.m_storage))
+            detail::fail_constant_evaluation();
+        return set;
+    }
+
+    friend constexpr result_set operator&(
+        result_set const &lhs, result_set const &rhs)
+    {
+        auto set = lhs;
+        set.m_storage.intersect(rhs.m_storage);
+        return set;
+    }
+
+private:
+    using storage = std::conditional_t<
+        is_direct,
+        detail::direct_result_bitmap<underlaying_type>,
+        detail::hashed_result_table<underlaying_type, HashedCapacity>>;
+
+    storage m_storage{};
+};
+
+template <typename Result, size_t HashedCapacity>
+constexpr bool result_set<Result, HashedCapacity>::is_direct;
+
+}  // namespace respp
@@ -0,0 +1,273 @@
+#pragma once
+
+#include "respp/result.hpp"
+
+namespace respp
+{
+// Mapping of the foreign code (errno, HTTP status, gRPC status etc.) to the
+// result value
+template <typename Code, typename Result>
+struct code_mapping {
+    Code code;
+    Result result;
+};
+
+template <typename Code, typename Result, size_t N>
+struct code_mappings {
+    using code_type = Code;
+    using result = Result;
+    static constexpr size_t size = N;
+
+    // result for the codes not present in the mapping
+    result fallback;
+    code_mapping<Code, Result> entries[N];
+};
+
+template <typename Code, typename Result, size_t N>
+constexpr size_t code_mappings<Code, Result, N>::size;
+
+template <typename Code, typename Result, size_t N>
+constexpr code_mappings<Code, Result, N> make_code_mappings(
+    Result const &fallback, code_mapping<Code, Result> const (&entries)[N])
+{
+    code_mappings<Code, Result, N> mappings{fallback, {}};
+    for (size_t i = 0; i < N; ++i)
+        mappings.entries[i] = entries[i];
+    return mappings;
+}
+
+namespace detail
+{
+template <typename Code>
+constexpr int64_t code_value(Code const code)
+{
+    return static_cast<int64_t>(code);
+}
+
+template <typename Mappings>
+constexpr int64_t min_code(Mappings const &mappings)
+{
+    auto value = code_value(mappings.entries[0].code);
+    for (auto const &e : mappings.entries)
+        value = code_value(e.code) < value ? code_value(e.code) : value;
+    return value;
+}
+
+template <typename Mappings>
+constexpr int64_t max_code(Mappings const &mappings)
+{
+    auto value = code_value(mappings.entries[0].code);
+    for (auto const &e : mappings.entries)
+        value = code_value(e.code) > value ? code_value(e.code) : value;
+    return value;
+}
+
+// stable, so that the first of the equal keys declared stays the first
+template <typename Mapping, size_t N, typename Less>
+constexpr void insertion_sort(Mapping (&entries)[N], Less less)
+{
+    for (size_t i = 1; i < N; ++i) {
+        auto const e = entries[i];
+        auto j = i;
+        for (; j > 0 && less(e, entries[j - 1]); --j)
+            entries[j] = entries[j - 1];
+        entries[j] = e;
+    }
+}
+
+struct code_less {
+    template <typename Mapping>
+    constexpr bool operator()(Mapping const &lhs, Mapping const &rhs) const
+    {
+        return code_value(lhs.code) < code_value(rhs.code);
+    }
+};
+
+struct result_less {
+    template <typename Mapping>
+    constexpr bool operator()(Mapping const &lhs, Mapping const &rhs) const
+    {
+        return lhs.result.result < rhs.result.result;
+    }
+};
+
+// Array of results indexed by the code offset from the smallest one
+template <typename Mappings, size_t Range>
+struct dense_lookup {
+    using code_type = typename Mappings::code_type;
+    using result = typename Mappings::result;
+
+    int64_t first_code{};
+    result fallback{};
+    result values[Range]{};
+
+    constexpr explicit dense_lookup(Mappings const &mappings)
+        : first_code(min_code(mappings)), fallback(mappings.fallback)
+    {
+        for (auto &v : values)
+            v = fallback;
+        // filled backwards for the first declaration to win
+        for (auto i = Mappings::size; i > 0; --i) {
+            auto const &e = mappings.entries[i - 1];
+            values[code_value(e.code) - first_code] = e.result;
+        }
+    }
+
+    constexpr result find(code_type const code) const
+    {
+        auto const index = static_cast<uint64_t>(code_value(code) - first_code);
+        return index < Range ? values[index] : fallback;
+    }
+};
+
+// Mappings sorted by code for the binary search
+template <typename Mappings>
+struct sorted_lookup {
+    using code_type = typename Mappings::code_type;
+    using result = typename Mappings::result;
+    using mapping = code_mapping<code_type, result>;
+
+    result fallback{};
+    mapping entries[Mappings::size]{};
+
+    constexpr explicit sorted_lookup(Mappings const &mappings)
+        : fallback(mappings.fallback)
+    {
+        for (size_t i = 0; i < Mappings::size; ++i)
+            entries[i] = mappings.entries[i];
+        insertion_sort(entries, code_less{});
+    }
+
+    constexpr result find(code_type const code) const
+    {
+        size_t first = 0;
+        size_t count = Mappings::size;
+        while (count) {
+            auto const half = count / 2;
+            if (code_value(entries[first + half].code) < code_value(code)) {
+                first += half + 1;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+        return first < Mappings::size && code_value(entries[first].code)
+                                             == code_value(code)
+                   ? entries[first].result
+                   : fallback;
+    }
+};
+
+// Mappings sorted by result for the reverse translation
+template <typename Mappings>
+struct reverse_lookup {
+    using code_type = typename Mappings::code_type;
+    using result = typename Mappings::result;
+    using mapping = code_mapping<code_type, result>;
+
+    mapping entries[Mappings::size]{};
+
+    constexpr explicit reverse_lookup(Mappings const &mappings)
+    {
+        for (size_t i = 0; i < Mappings::size; ++i)
+            entries[i] = mappings.entries[i];
+        insertion_sort(entries, result_less{});
+    }
+
+    constexpr code_type find(
+        result const &r, code_type const fallback_code) const
+    {
+        size_t first = 0;
+        size_t count = Mappings::size;
+        while (count) {
+            auto const half = count / 2;
+            if (entries[first + half].result.result < r.result) {
+                first += half + 1;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+        return first < Mappings::size && entries[first].result == r
+                   ? entries[first].code
+                   : fallback_code;
+    }
+};
+}  // namespace detail
+
+// Translation between the foreign codes and the results declared once by
+// the table type providing static constexpr mappings() function:
+//
+// struct HttpStatuses {
+//     static constexpr auto mappings()
+//     {
+//         return respp::make_code_mappings<int, Result>(
+//             unknownError, {{404, notFoundError}, {503, unavailableError}});
+//     }
+// };
+// constexpr auto r = respp::translation_t<HttpStatuses>::to_result(404);
+//
+// Compact code ranges are translated via the dense array (single indexed
+// load), sparse ones via the sorted table.
+template <typename Table>
+class translation_t {
+    using mappings_type = decltype(Table::mappings());
+
+public:
+    using code_type = typename mappings_type::code_type;
+    using result = typename mappings_type::result;
+
+    static constexpr uint64_t code_range
+        = detail::max_code(Table::mappings())
+          - detail::min_code(Table::mappings()) + 1;
+
+    static constexpr uint64_t sorted_table_bytes
+        = mappings_type::size * sizeof(code_mapping<code_type, result>);
+
+    // dense array is used unless it is twice as large as the sorted table,
+    // arrays up to 256 bytes are always dense
+    static constexpr bool is_dense
+        = code_range * sizeof(result)
+          <= (2 * sorted_table_bytes > 256 ? 2 * sorted_table_bytes : 256);
+
+    using forward_lookup = std::conditional_t<
+        is_dense,
+        detail::dense_lookup<mappings_type, is_dense ? code_range : 1>,
+        detail::sorted_lookup<mappings_type>>;
+    using backward_lookup = detail::reverse_lookup<mappings_type>;
+
+    static constexpr result to_result(code_type const code)
+    {
+        return forward.find(code);
+    }
+
+    // the first code declared for the result or fallback_code
+    static constexpr code_type to_code(
+        result const &r, code_type const fallback_code)
+    {
+        return backward.find(r, fallback_code);
+    }
+
+private:
+    static constexpr forward_lookup forward{Table::mappings()};
+    static constexpr backward_lookup backward{Table::mappings()};
+};
+
+template <typename Table>
+constexpr uint64_t translation_t<Table>::code_range;
+
+template <typename Table>
+constexpr uint64_t translation_t<Table>::sorted_table_bytes;
+
+template <typename Table>
+constexpr bool translation_t<Table>::is_dense;
+
+template <typename Table>
+constexpr typename translation_t<Table>::forward_lookup
+    translation_t<Table>::forward;
+
+template <typename Table>
+constexpr typename translation_t<Table>::backward_lookup
+    translation_t<Table>::backward;
+
+}  // namespace respp
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "respp/result.hpp"
+
+#include <type_traits>
+
+#if defined(__GNUC__)
+#define RESPP_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#define RESPP_COLD __attribute__((cold, noinline))
+#define RESPP_ALWAYS_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define RESPP_UNLIKELY(x) (x)
+#define RESPP_COLD __declspec(noinline)
+#define RESPP_ALWAYS_INLINE __forceinline
+#else
+#define RESPP_UNLIKELY(x) (x)
+#define RESPP_COLD
+#define RESPP_ALWAYS_INLINE inline
+#endif
+
+namespace respp
+{
+namespace detail
+{
+// the failure is a result or the same kind of aggregate as returned
+template <typename Aggregate, typename Failure>
+Aggregate make_propagated(Failure const &failure, std::true_type)
+{
+    return Aggregate(failure);
+}
+
+// the failure is another kind of aggregate (aggregate result propagated to
+// the error tree), its errors are appended causes first
+template <typename Aggregate, typename Failure>
+Aggregate make_propagated(Failure const &failure, std::false_type)
+{
+    Aggregate result{};
+    for (auto const error : failure.iterate_errors())
+        result.append(error);
+    return result;
+}
+
+// Out of line, so that only the call remains on the hot path. The arguments
+// are passed by value to keep them in registers.
+template <typename Aggregate, typename Failure, typename Context>
+RESPP_COLD Aggregate propagate_failure(Failure failure, Context context)
+{
+    auto result = make_propagated<Aggregate>(
+        failure, std::is_constructible<Aggregate, Failure const &>{});
+    result.append(context);
+    return result;
+}
+
+// Failed result with the context of the current layer, converted to the
+// aggregate result returned by the enclosing function. The conversion is
+// inlined, so the object is never materialized.
+template <typename Failure, typename Context>
+class propagated_failure {
+public:
+    constexpr propagated_failure(Failure const &failure, Context const &context)
+        : m_failure(failure), m_context(context)
+    {}
+
+    template <typename Aggregate>
+    RESPP_ALWAYS_INLINE operator Aggregate() const
+    {
+        return propagate_failure<Aggregate>(m_failure, m_context);
+    }
+
+private:
+    Failure m_failure;
+    Context m_context;
+};
+
+template <typename Failure, typename Context>
+constexpr propagated_failure<Failure, Context> propagate(
+    Failure const &failure, Context const &context)
+{
+    return {failure, context};
+}
+}  // namespace detail
+}  // namespace respp
+
+// Evaluates the expression returning single or aggregate result. On failure
+// returns it from the enclosing function with the context appended, as in
+// 'return AggregateResult{result} << context'. The enclosing function should
+// return aggregate result or error tree, an aggregate result propagated to the
+// error tree becomes the chain of causes of the context.
+#define RESPP_TRY(expr, context)                                          \
+    do {                                                                  \
+        auto const respp_try_result_ = (expr);                            \
+        if (RESPP_UNLIKELY(!::respp::is_success(respp_try_result_)))      \
+            return ::respp::detail::propagate(respp_try_result_, context); \
+    } while (false)
@@ -0,0 +1,8 @@
+#include "probe.hpp"
+
+using namespace size_probe;
+
+extern "C" uint32_t probe_get_category(uint8_t result)
+{
+    return respp::get_category<SubCategory>(Result{result}).value;
+}
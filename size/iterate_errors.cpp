@@ -0,0 +1,14 @@
+#include "probe.hpp"
+
+using namespace size_probe;
+
+extern "C" int probe_iterate_errors(uint32_t container)
+{
+    AggregateResult r;
+    r.container = container;
+    auto count = 0;
+    for (auto const it : r.iterate_errors())
+        if (it == rpcError)
+            ++count;
+    return count;
+}
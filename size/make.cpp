@@ -0,0 +1,8 @@
+#include "probe.hpp"
+
+using namespace size_probe;
+
+extern "C" uint8_t probe_make(uint32_t category, uint32_t sub, uint8_t code)
+{
+    return Result::make(Category{category}, SubCategory{sub}, code).result;
+}
@@ -0,0 +1,11 @@
+#include "probe.hpp"
+
+using namespace size_probe;
+
+extern "C" uint32_t probe_place_while_space_is_available(
+    uint32_t container, uint8_t result)
+{
+    AggregateResult r;
+    r.container = container;
+    return (r << Result{result}).container;
+}
@@ -0,0 +1,24 @@
+// Result types shared by the code size probes. The layout follows the README:
+// 8-bit results with two 2-bit categories aggregated in 32-bit container.
+
+#pragma once
+
+#include "respp/result.hpp"
+
+namespace size_probe
+{
+MAKE_RESULT_CATEGORY(Category, 2);
+MAKE_RESULT_CATEGORY(SubCategory, 2);
+
+MAKE_RESULT_TYPE(Result, uint8_t, Category, SubCategory);
+
+using AggregateResult = respp::aggregate_result_t<uint32_t, Result>;
+using ReplaceTopmostResult = respp::aggregate_result_t<
+    uint32_t,
+    Result,
+    respp::detail::replace_topmost<uint32_t, Result>>;
+
+constexpr auto Backend = Category{2};
+constexpr auto Rpc = SubCategory{2};
+constexpr auto rpcError = Result::make(Backend, Rpc, 1);
+}  // namespace size_probe
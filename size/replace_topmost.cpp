@@ -0,0 +1,10 @@
+#include "probe.hpp"
+
+using namespace size_probe;
+
+extern "C" uint32_t probe_replace_topmost(uint32_t container, uint8_t result)
+{
+    ReplaceTopmostResult r;
+    r.container = container;
+    return (r << Result{result}).container;
+}
@@ -0,0 +1,70 @@
+#!/bin/sh
+# Compiles the code size probes with -Os for the host compiler ($CXX, g++ by
+# default) and for the cross-compiler ($CROSS_CXX, arm-none-eabi-g++ if found)
+# in the default and in the size optimized (RESPP_OPTIMIZE_FOR_SIZE)
+# configurations. Reports .text bytes of every probe and fails if any of them
+# exceeds the budget of the toolchain from budgets.txt. The cross budgets are
+# advisory unless CROSS_BUDGETS=enforced.
+
+SIZE_DIR=$(dirname "$0")
+INCLUDE_DIR="$SIZE_DIR/../include"
+OUT_DIR=${OUT_DIR:-bin/size}
+HOST_CXX=${CXX:-g++}
+CROSS_CXX=${CROSS_CXX:-arm-none-eabi-g++}
+CROSS_BUDGETS=${CROSS_BUDGETS:-advisory}
+
+mkdir -p "$OUT_DIR"
+
+compilers=$HOST_CXX
+if command -v "$CROSS_CXX" > /dev/null 2>&1; then
+    compilers="$compilers $CROSS_CXX"
+else
+    echo "cross-compiler $CROSS_CXX is not found, reporting host only"
+fi
+
+status=0
+printf '%-20s %-10s %-32s %6s %6s\n' compiler config probe bytes budget
+
+for cxx in $compilers; do
+    # binutils of the toolchain: arm-none-eabi-g++ -> arm-none-eabi-size
+    size_tool=$(echo "$cxx" | sed 's/[gc]++$/size/')
+    command -v "$size_tool" > /dev/null 2>&1 || size_tool=size
+
+    enforced=1
+    if [ "$cxx" != "$HOST_CXX" ] && [ "$CROSS_BUDGETS" != enforced ]; then
+        enforced=0
+    fi
+
+    for config in default size; do
+        flags="-std=c++14 -Os -I$INCLUDE_DIR"
+        [ "$config" = size ] && flags="$flags -DRESPP_OPTIMIZE_FOR_SIZE"
+
+        grep -v '^#' "$SIZE_DIR/budgets.txt" | {
+            failed=0
+            while read -r probe host_budget cross_budget; do
+                [ -n "$probe" ] || continue
+                budget=$host_budget
+                [ "$cxx" = "$HOST_CXX" ] || budget=$cross_budget
+                object="$OUT_DIR/$(basename "$cxx")-$config-$probe.o"
+                $cxx $flags -c "$SIZE_DIR/$probe.cpp" -o "$object" || exit 1
+
+                bytes=$("$size_tool" -A "$object" \
+                    | awk '$1 ~ /^\.text/ { sum += $2 } END { print sum + 0 }')
+                verdict=""
+                if [ "$bytes" -gt "$budget" ]; then
+                    if [ "$enforced" -eq 1 ]; then
+                        verdict="over budget"
+                        failed=1
+                    else
+                        verdict="over budget (advisory)"
+                    fi
+                fi
+                printf '%-20s %-10s %-32s %6s %6s %s\n' \
+                    "$cxx" "$config" "$probe" "$bytes" "$budget" "$verdict"
+            done
+            exit $failed
+        } || status=1
+    done
+done
+
+exit $status
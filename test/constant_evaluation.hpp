@@ -0,0 +1,21 @@
+#pragma once
+
+#include <type_traits>
+
+namespace test_helpers
+{
+// Maker::make() can be evaluated in a constant expression
+template <typename Maker>
+constexpr auto is_constant(int) -> decltype(
+    std::integral_constant<bool, (static_cast<void>(Maker::make()), true)>{},
+    true)
+{
+    return true;
+}
+
+template <typename Maker>
+constexpr bool is_constant(...)
+{
+    return false;
+}
+}  // namespace test_helpers
@@ -0,0 +1,201 @@
+#include "respp/error_tree.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace error_tree_tests
+{
+MAKE_RESULT_CATEGORY(Domain, 2);
+MAKE_RESULT_CATEGORY(SubDomain, 2);
+MAKE_RESULT_TYPE(TestResult, uint8_t, Domain, SubDomain);
+
+constexpr auto Networking = Domain{1};
+constexpr auto Backend = Domain{2};
+constexpr auto Application = Domain{3};
+
+constexpr auto Tcp = SubDomain{1};
+constexpr auto Db = SubDomain{1};
+constexpr auto Rpc = SubDomain{2};
+constexpr auto Server = SubDomain{1};
+
+constexpr auto requestError = TestResult::make(Application, Server, 1);
+constexpr auto queryError = TestResult::make(Backend, Db, 1);
+constexpr auto rpcError = TestResult::make(Backend, Rpc, 1);
+constexpr auto connectionError = TestResult::make(Networking, Tcp, 1);
+
+using error_tree = respp::error_tree_t<TestResult, 8>;
+
+static_assert(
+    respp::is_success(error_tree{}), "Empty tree should be a success");
+static_assert(
+    !respp::is_success(error_tree{queryError, requestError}),
+    "Tree should be constructed at compile time");
+
+template <typename Iterator>
+std::vector<uint8_t> values(respp::iterator_pair<Iterator> const &range)
+{
+    std::vector<uint8_t> results;
+    for (auto const it : range)
+        results.push_back(it.result);
+    return results;
+}
+
+TEST(ErrorTree, Intialized_with_default_value)
+{
+    error_tree e;
+
+    EXPECT_TRUE(respp::is_success(e));
+    EXPECT_EQ(e.size(), 0);
+    EXPECT_EQ(e.root(), error_tree::npos);
+    EXPECT_TRUE(values(e.iterate_errors()).empty());
+    EXPECT_EQ(e, error_tree{TestResult::success});
+}
+
+TEST(ErrorTree, Appended_results_are_stacked_as_in_aggregate_result)
+{
+    error_tree e(connectionError);
+    e << rpcError << TestResult::success << requestError;
+
+    EXPECT_FALSE(respp::is_success(e));
+    EXPECT_EQ(e.size(), 3);
+    EXPECT_EQ(e.root(), 2);
+    EXPECT_EQ(e.parent(0), 1);
+    EXPECT_EQ(e.parent(1), 2);
+    EXPECT_EQ(e.parent(2), error_tree::npos);
+
+    std::vector<uint8_t> const expected{
+        connectionError.result, rpcError.result, requestError.result};
+    EXPECT_EQ(values(e.iterate_errors()), expected);
+    EXPECT_EQ(e, (error_tree{connectionError, rpcError, requestError}));
+
+    std::vector<uint8_t> const expected_preorder{
+        requestError.result, rpcError.result, connectionError.result};
+    EXPECT_EQ(values(e.iterate_preorder()), expected_preorder);
+}
+
+TEST(ErrorTree, Appended_results_are_iterated_as_in_aggregate_result)
+{
+    using aggregate_result = respp::aggregate_result_t<uint32_t, TestResult>;
+    aggregate_result a(connectionError);
+    a << rpcError << queryError << requestError;
+    error_tree e(connectionError);
+    e << rpcError << queryError << requestError;
+
+    EXPECT_EQ(values(e.iterate_errors()), values(a.iterate_errors()));
+}
+
+TEST(ErrorTree, Sibling_causes_keep_their_parent)
+{
+    error_tree e(requestError);
+    auto const query = e.append_child(e.root(), queryError);
+    auto const rpc = e.append_child(e.root(), rpcError);
+    auto const connection = e.append_child(rpc, connectionError);
+
+    EXPECT_EQ(e.parent(query), e.root());
+    EXPECT_EQ(e.parent(rpc), e.root());
+    EXPECT_EQ(e.parent(connection), rpc);
+
+    std::vector<uint8_t> const expected{
+        queryError.result,
+        connectionError.result,
+        rpcError.result,
+        requestError.result};
+    EXPECT_EQ(values(e.iterate_errors()), expected);
+
+    std::vector<uint8_t> const expected_preorder{
+        requestError.result,
+        queryError.result,
+        rpcError.result,
+        connectionError.result};
+    EXPECT_EQ(values(e.iterate_preorder()), expected_preorder);
+
+    std::vector<uint8_t> const expected_subtree{
+        connectionError.result, rpcError.result};
+    EXPECT_EQ(values(e.iterate_subtree(rpc)), expected_subtree);
+
+    std::vector<uint8_t> const expected_subtree_preorder{
+        rpcError.result, connectionError.result};
+    EXPECT_EQ(values(e.iterate_preorder(rpc)), expected_subtree_preorder);
+
+    // new context keeps the whole tree as its cause
+    auto const context = e.append_parent(requestError);
+    EXPECT_EQ(e.root(), context);
+    EXPECT_EQ(e.parent(0), context);
+    EXPECT_EQ(values(e.iterate_errors()).size(), 5u);
+}
+
+TEST(ErrorTree, Failures_are_tracked_per_subtree)
+{
+    error_tree e;
+    auto const root = e.append_parent(TestResult::success);
+    auto const ok_branch = e.append_child(root, TestResult::success);
+    auto const failed_branch = e.append_child(root, TestResult::success);
+
+    EXPECT_TRUE(respp::is_success(e));
+
+    auto const leaf = e.append_child(failed_branch, rpcError);
+
+    EXPECT_FALSE(respp::is_success(e));
+    EXPECT_TRUE(e.any_failure_under(root));
+    EXPECT_FALSE(e.any_failure_under(ok_branch));
+    EXPECT_TRUE(e.any_failure_under(failed_branch));
+    EXPECT_TRUE(e.any_failure_under(leaf));
+
+    auto const new_root = e.append_parent(TestResult::success);
+    EXPECT_TRUE(e.any_failure_under(new_root));
+}
+
+TEST(ErrorTree, Results_appended_to_the_full_tree_are_dropped)
+{
+    respp::error_tree_t<TestResult, 2> e{queryError, rpcError};
+
+    EXPECT_EQ(e.append_parent(requestError), e.npos);
+    EXPECT_EQ(e.append_child(e.root(), requestError), e.npos);
+    e << requestError;
+
+    EXPECT_EQ(e.size(), 2);
+    EXPECT_EQ(e[e.root()], rpcError);
+}
+
+TEST(ErrorTree, Parent_indices_spanning_several_words)
+{
+    using large_tree = respp::error_tree_t<TestResult, 64>;
+    large_tree e(requestError);
+    for (uint8_t i = 1; i < large_tree::capacity; ++i)
+        ASSERT_EQ(e.append_child(i - 1, rpcError), i);
+
+    EXPECT_EQ(e.append_child(0, rpcError), large_tree::npos);
+    for (uint8_t i = 1; i < large_tree::capacity; ++i)
+        EXPECT_EQ(e.parent(i), i - 1);
+    EXPECT_EQ(e.parent(0), large_tree::npos);
+    EXPECT_TRUE(e.any_failure_under(large_tree::capacity - 1));
+    EXPECT_EQ(values(e.iterate_subtree(60)).size(), 4u);
+    EXPECT_EQ(values(e.iterate_preorder(60)).size(), 4u);
+}
+
+TEST(ErrorTree, Subtree_out_of_the_tree_is_empty)
+{
+    error_tree e(requestError);
+
+    EXPECT_TRUE(values(e.iterate_preorder(5)).empty());
+    EXPECT_TRUE(values(e.iterate_preorder(40)).empty());
+    EXPECT_TRUE(values(e.iterate_preorder(error_tree::npos)).empty());
+    EXPECT_TRUE(values(e.iterate_subtree(5)).empty());
+    EXPECT_TRUE(values(e.iterate_subtree(40)).empty());
+    EXPECT_FALSE(e.any_failure_under(5));
+}
+
+TEST(ErrorTree, Empty_tree_of_full_capacity)
+{
+    using large_tree = respp::error_tree_t<TestResult, 64>;
+    large_tree e;
+
+    EXPECT_EQ(e.root(), large_tree::npos);
+    EXPECT_FALSE(e.any_failure_under(e.root()));
+    EXPECT_TRUE(respp::is_success(e));
+    EXPECT_TRUE(values(e.iterate_errors()).empty());
+    EXPECT_TRUE(values(e.iterate_preorder()).empty());
+}
+
+}  // namespace error_tree_tests
@@ -0,0 +1,114 @@
+#include "respp/indexed_results.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+namespace indexed_results_tests
+{
+MAKE_RESULT_CATEGORY(Domain, 2);
+MAKE_RESULT_CATEGORY(SubDomain, 2);
+MAKE_RESULT_TYPE(TestResult, uint8_t, Domain, SubDomain);
+
+constexpr auto Networking = Domain{1};
+constexpr auto Backend = Domain{2};
+
+constexpr auto Tcp = SubDomain{1};
+constexpr auto Rpc = SubDomain{2};
+
+constexpr auto rpcError = TestResult::make(Backend, Rpc, 1);
+constexpr auto connectionError = TestResult::make(Networking, Tcp, 1);
+
+template <typename Iterator>
+std::vector<size_t> indices(respp::iterator_pair<Iterator> const &range)
+{
+    std::vector<size_t> result;
+    for (auto const index : range)
+        result.push_back(index);
+    return result;
+}
+
+TEST(IndexedResults, Intialized_with_default_value)
+{
+    respp::indexed_results_t<TestResult, 100> results;
+
+    EXPECT_FALSE(results.any_failure());
+    EXPECT_EQ(results.failure_count(), 0u);
+    EXPECT_EQ(results.find_next_failure(0), results.npos);
+    EXPECT_TRUE(indices(results.iterate_failures()).empty());
+    EXPECT_EQ(results[99], TestResult::success);
+}
+
+TEST(IndexedResults, Failures_are_indexed_on_write)
+{
+    respp::indexed_results_t<TestResult, 100> results;
+
+    results.set(3, rpcError);
+    results.set(64, connectionError);
+    results.set(99, rpcError);
+    results.set(10, TestResult::success);
+
+    EXPECT_TRUE(results.any_failure());
+    EXPECT_EQ(results.failure_count(), 3u);
+    EXPECT_EQ(results[64], connectionError);
+    EXPECT_EQ(
+        indices(results.iterate_failures()), (std::vector<size_t>{3, 64, 99}));
+    EXPECT_EQ(results.find_next_failure(4), 64u);
+
+    results.set(64, rpcError);
+    results.set(3, TestResult::success);
+    results.set(99, TestResult::success);
+
+    EXPECT_EQ(results.failure_count(), 1u);
+    EXPECT_EQ(indices(results.iterate_failures()), (std::vector<size_t>{64}));
+
+    results.set(64, TestResult::success);
+    EXPECT_FALSE(results.any_failure());
+}
+
+TEST(IndexedResults, Sparse_failures_in_large_array_are_found_via_summaries)
+{
+    // 2^20 entries: three levels of bitmap above the results
+    using large_results = respp::indexed_results_t<TestResult, 1 << 20>;
+    auto const results = std::make_unique<large_results>();
+
+    std::vector<size_t> const expected{0, 4095, 4096, 262143, 700001, 1048575};
+    for (auto const index : expected)
+        results->set(index, rpcError);
+
+    EXPECT_EQ(indices(results->iterate_failures()), expected);
+
+    results->set(4096, TestResult::success);
+    EXPECT_EQ(results->find_next_failure(4096), 262143u);
+    EXPECT_EQ(results->find_next_failure(1048575), 1048575u);
+}
+
+TEST(IndexedResults, Failures_are_indexed_per_selected_category)
+{
+    respp::indexed_results_t<TestResult, 200, Domain, SubDomain> results;
+
+    results.set(1, rpcError);
+    results.set(150, connectionError);
+    results.set(199, TestResult::make(Backend, Tcp, 2));
+
+    EXPECT_TRUE(results.any_failure(Backend));
+    EXPECT_FALSE(results.any_failure(Domain{3}));
+    EXPECT_EQ(
+        indices(results.iterate_failures(Backend)),
+        (std::vector<size_t>{1, 199}));
+    EXPECT_EQ(
+        indices(results.iterate_failures(Tcp)),
+        (std::vector<size_t>{150, 199}));
+
+    results.set(199, TestResult::success);
+    results.set(1, connectionError);
+
+    EXPECT_FALSE(results.any_failure(Backend));
+    EXPECT_FALSE(results.any_failure(Rpc));
+    EXPECT_EQ(
+        indices(results.iterate_failures(Networking)),
+        (std::vector<size_t>{1, 150}));
+}
+
+}  // namespace indexed_results_tests
@@ -0,0 +1,162 @@
+#include "respp/predicate.hpp"
+
+#include "constant_evaluation.hpp"
+
+#include <gtest/gtest.h>
+
+namespace predicate_tests
+{
+using namespace respp::predicates;
+using test_helpers::is_constant;
+
+MAKE_RESULT_CATEGORY(Domain, 2);
+MAKE_RESULT_CATEGORY(SubDomain, 2);
+MAKE_RESULT_TYPE(TestResult, uint8_t, Domain, SubDomain);
+MAKE_RESULT_TYPE(WideTestResult, uint16_t, Domain, SubDomain);
+
+constexpr auto Networking = Domain{1};
+constexpr auto Backend = Domain{2};
+
+constexpr auto Tcp = SubDomain{1};
+constexpr auto Db = SubDomain{1};
+constexpr auto Rpc = SubDomain{2};
+
+constexpr auto backendFailure = respp::compile_predicate<TestResult>(
+    is(Backend) && is_any_of(Db, Rpc) && !has_code(0));
+
+static_assert(
+    backendFailure.term_count() == 2,
+    "Single term is expected per sub-category");
+static_assert(
+    backendFailure(TestResult::make(Backend, Rpc, 3)),
+    "Predicate should be evaluated at compile time");
+
+TEST(Predicate, Single_result_is_matched_by_categories_and_code)
+{
+    EXPECT_TRUE(backendFailure(TestResult::make(Backend, Db, 1)));
+    EXPECT_TRUE(backendFailure(TestResult::make(Backend, Rpc, 15)));
+    EXPECT_FALSE(backendFailure(TestResult::make(Backend, Rpc, 0)));
+    EXPECT_FALSE(backendFailure(TestResult::make(Backend, SubDomain{3}, 1)));
+    EXPECT_FALSE(backendFailure(TestResult::make(Networking, Tcp, 1)));
+    EXPECT_FALSE(backendFailure(TestResult::success));
+}
+
+TEST(Predicate, Compiled_predicate_matches_direct_evaluation_for_all_values)
+{
+    constexpr auto predicate = respp::compile_predicate<TestResult>(
+        !(is(Networking) || has_any_code(1, 2))
+        || (is(Backend) && !is_any_of(Db, Rpc)));
+
+    for (auto v = 0; v <= UINT8_MAX; ++v) {
+        TestResult const r{static_cast<uint8_t>(v)};
+        auto const domain = respp::get_category<Domain>(r);
+        auto const sub_domain = respp::get_category<SubDomain>(r);
+        auto const code = respp::get_code(r);
+
+        auto const expected
+            = !(domain == Networking || code == 1 || code == 2)
+              || (domain == Backend
+                  && !(sub_domain == Db || sub_domain == Rpc));
+        EXPECT_EQ(predicate(r), expected) << v;
+    }
+}
+
+struct CodeInRange {
+    static constexpr auto make()
+    {
+        return respp::compile_predicate<TestResult>(has_code(15));
+    }
+};
+
+struct CodeOutOfRange {
+    static constexpr auto make()
+    {
+        return respp::compile_predicate<TestResult>(has_code(17));
+    }
+};
+
+struct CategoryOutOfRange {
+    static constexpr auto make()
+    {
+        return respp::compile_predicate<TestResult>(is(Domain{5}));
+    }
+};
+
+static_assert(is_constant<CodeInRange>(0), "");
+static_assert(
+    !is_constant<CodeOutOfRange>(0),
+    "Code wider than the code field should be rejected at compile time");
+static_assert(
+    !is_constant<CategoryOutOfRange>(0),
+    "Category value wider than its field should be rejected at compile time");
+
+TEST(Predicate, Values_out_of_the_field_range_never_match)
+{
+    auto const code = CodeOutOfRange::make();
+    auto const not_code
+        = respp::compile_predicate<TestResult>(!has_any_code(17, 1));
+    auto const category = CategoryOutOfRange::make();
+
+    for (auto v = 0; v <= UINT8_MAX; ++v) {
+        TestResult const r{static_cast<uint8_t>(v)};
+        EXPECT_FALSE(code(r)) << v;
+        EXPECT_FALSE(category(r)) << v;
+        EXPECT_EQ(not_code(r), respp::get_code(r) != 1) << v;
+    }
+}
+
+TEST(Predicate, Contradicting_conditions_are_dropped_at_compile_time)
+{
+    constexpr auto never = respp::compile_predicate<TestResult>(
+        is(Backend) && is(Networking));
+    constexpr auto decided = respp::compile_predicate<TestResult>(
+        is(Backend) && !is(Networking) && !has_code(0));
+
+    static_assert(never.term_count() == 0, "");
+    static_assert(decided.term_count() == 1, "");
+
+    EXPECT_FALSE(never(TestResult::make(Backend, Db, 1)));
+    EXPECT_TRUE(decided(TestResult::make(Backend, Db, 1)));
+    EXPECT_FALSE(decided(TestResult::make(Backend, Db, 0)));
+}
+
+TEST(Predicate, Aggregate_slots_are_tested_at_once)
+{
+    using aggregate_result = respp::aggregate_result_t<uint32_t, TestResult>;
+
+    aggregate_result const e{
+        TestResult::make(Networking, Tcp, 1),
+        TestResult::make(Backend, Rpc, 2),
+        TestResult::make(Backend, Rpc, 0)};
+
+    EXPECT_EQ(backendFailure.matching_slots(e), 0b010);
+    EXPECT_TRUE(backendFailure.any_slot(e));
+
+    constexpr auto successful
+        = respp::compile_predicate<TestResult>(has_code(0) && is(Domain{0}));
+    EXPECT_EQ(successful.matching_slots(e), 0);
+    EXPECT_EQ(successful.matching_slots(aggregate_result{}), 0);
+    EXPECT_FALSE(backendFailure.any_slot(aggregate_result{}));
+}
+
+TEST(Predicate, Array_is_filtered_in_words_and_tail)
+{
+    constexpr auto predicate = respp::compile_predicate<WideTestResult>(
+        is(Backend) && !has_code(0));
+
+    WideTestResult results[11]{};
+    for (auto i = 0; i < 11; ++i)
+        results[i] = WideTestResult::make(
+            (i % 3) ? Backend : Networking, Db, static_cast<uint16_t>(i));
+
+    WideTestResult filtered[11]{};
+    auto const end
+        = predicate.filter(std::begin(results), std::end(results), filtered);
+
+    uint16_t const expected_codes[] = {1, 2, 4, 5, 7, 8, 10};
+    ASSERT_EQ(end - filtered, 7);
+    for (auto i = 0; i < 7; ++i)
+        EXPECT_EQ(respp::get_code(filtered[i]), expected_codes[i]);
+}
+
+}  // namespace predicate_tests
@@ -0,0 +1,187 @@
+#include "respp/result_map.hpp"
+
+#include "constant_evaluation.hpp"
+#include "respp/hash.hpp"
+
+#include <gtest/gtest.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace result_map_tests
+{
+using test_helpers::is_constant;
+
+MAKE_RESULT_CATEGORY(Domain, 2);
+MAKE_RESULT_CATEGORY(SubDomain, 2);
+MAKE_RESULT_TYPE(TestResult, uint8_t, Domain, SubDomain);
+MAKE_RESULT_TYPE(WideTestResult, uint32_t, Domain, SubDomain);
+MAKE_AGGREGATE_RESULT_TYPE(AggregateResult, uint32_t, TestResult);
+
+constexpr auto Networking = Domain{1};
+constexpr auto Backend = Domain{2};
+
+constexpr auto Tcp = SubDomain{1};
+constexpr auto Db = SubDomain{1};
+constexpr auto Rpc = SubDomain{2};
+
+constexpr auto connectionError = TestResult::make(Networking, Tcp, 1);
+constexpr auto timeoutError = TestResult::make(Networking, Tcp, 2);
+constexpr auto queryError = TestResult::make(Backend, Db, 1);
+constexpr auto rpcError = TestResult::make(Backend, Rpc, 1);
+
+static_assert(respp::result_map<TestResult, int>::is_direct, "");
+static_assert(!respp::result_map<WideTestResult, int>::is_direct, "");
+
+TEST(ResultMap_8bit, Retry_budget_per_error)
+{
+    respp::result_map<TestResult, int> budgets{
+        {connectionError, 3}, {timeoutError, 1}};
+
+    EXPECT_EQ(budgets.size(), 2u);
+    ASSERT_NE(budgets.find(connectionError), nullptr);
+    EXPECT_EQ(*budgets.find(connectionError), 3);
+    EXPECT_EQ(budgets.find(queryError), nullptr);
+
+    // the existing value is kept
+    EXPECT_EQ(*budgets.insert(timeoutError, 5), 1);
+    --*budgets.insert(timeoutError);
+    EXPECT_EQ(*budgets.find(timeoutError), 0);
+
+    EXPECT_EQ(budgets.insert(TestResult::success, 1), nullptr);
+    EXPECT_FALSE(budgets.contains(TestResult::success));
+
+    EXPECT_TRUE(budgets.erase(connectionError));
+    EXPECT_FALSE(budgets.erase(connectionError));
+    EXPECT_FALSE(budgets.contains(connectionError));
+    EXPECT_EQ(budgets.size(), 1u);
+}
+
+TEST(ResultMap_8bit, Iterates_entries_in_order_of_values)
+{
+    respp::result_map<TestResult, int> counters{};
+    ++*counters.insert(rpcError);
+    ++*counters.insert(connectionError);
+    ++*counters.insert(rpcError);
+
+    std::vector<std::pair<TestResult, int>> entries;
+    counters.for_each([&entries](TestResult const &r, int const count) {
+        entries.emplace_back(r, count);
+    });
+
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries[0].first, connectionError);
+    EXPECT_EQ(entries[0].second, 1);
+    EXPECT_EQ(entries[1].first, rpcError);
+    EXPECT_EQ(entries[1].second, 2);
+}
+
+TEST(ResultMap_32bit, Hashed_map_is_bounded_by_capacity)
+{
+    respp::result_map<WideTestResult, int, 8> map{};
+
+    for (uint32_t code = 1; code <= 8; ++code) {
+        auto const value = map.insert(
+            WideTestResult::make(Backend, Rpc, code), static_cast<int>(code));
+        ASSERT_NE(value, nullptr);
+    }
+    EXPECT_EQ(map.insert(WideTestResult::make(Backend, Rpc, 9)), nullptr);
+    EXPECT_EQ(map.size(), 8u);
+
+    EXPECT_TRUE(map.erase(WideTestResult::make(Backend, Rpc, 4)));
+    EXPECT_NE(map.insert(WideTestResult::make(Backend, Rpc, 9)), nullptr);
+    for (uint32_t code = 1; code <= 9; ++code) {
+        EXPECT_EQ(
+            map.contains(WideTestResult::make(Backend, Rpc, code)), code != 4)
+            << code;
+    }
+}
+
+using small_map = respp::result_map<WideTestResult, int, 2>;
+
+constexpr auto first = WideTestResult::make(Backend, Rpc, 1);
+constexpr auto second = WideTestResult::make(Backend, Rpc, 2);
+constexpr auto third = WideTestResult::make(Backend, Rpc, 3);
+
+struct FullMap {
+    static constexpr small_map make()
+    {
+        return {{first, 1}, {second, 2}};
+    }
+};
+
+struct OverflowedMap {
+    static constexpr small_map make()
+    {
+        return {{first, 1}, {second, 2}, {third, 3}};
+    }
+};
+
+static_assert(is_constant<FullMap>(0), "");
+static_assert(
+    !is_constant<OverflowedMap>(0),
+    "Entries not fitting the map should fail the constant initialization");
+
+TEST(ResultMap_32bit, Overflow_is_observable)
+{
+    auto full = FullMap::make();
+    EXPECT_FALSE(full.overflowed());
+    EXPECT_EQ(full.size(), 2u);
+
+    EXPECT_EQ(full.insert(third, 3), nullptr);
+    EXPECT_TRUE(full.overflowed());
+
+    auto const constructed = OverflowedMap::make();
+    EXPECT_TRUE(constructed.overflowed());
+    EXPECT_EQ(constructed.size(), 2u);
+
+    respp::result_map<TestResult, int> direct{{connectionError, 1}};
+    EXPECT_FALSE(direct.overflowed());
+}
+
+TEST(ResultMap_32bit, Erase_keeps_colliding_entries_reachable)
+{
+    respp::result_map<WideTestResult, uint32_t, 16> map{};
+    std::unordered_map<WideTestResult, uint32_t> reference;
+
+    uint32_t state = 1;
+    for (auto step = 0; step < 2000; ++step) {
+        state = state * 1664525u + 1013904223u;
+        auto const r
+            = WideTestResult::make(Backend, Db, (state >> 8) % 24 + 1);
+
+        if (state >> 31) {
+            EXPECT_EQ(map.erase(r), reference.erase(r) == 1);
+        } else if (reference.size() < 16 || reference.count(r)) {
+            ASSERT_NE(map.insert(r, state), nullptr);
+            reference.emplace(r, state);
+        }
+
+        ASSERT_EQ(map.size(), reference.size());
+        for (auto const &entry : reference) {
+            auto const value = map.find(entry.first);
+            ASSERT_NE(value, nullptr) << step;
+            EXPECT_EQ(*value, entry.second);
+        }
+    }
+}
+
+TEST(ResultHash, Results_are_keys_of_unordered_containers)
+{
+    std::unordered_map<TestResult, int> counters;
+    ++counters[connectionError];
+    ++counters[connectionError];
+    ++counters[queryError];
+
+    EXPECT_EQ(counters.size(), 2u);
+    EXPECT_EQ(counters[connectionError], 2);
+
+    std::unordered_set<AggregateResult> seen{
+        AggregateResult{connectionError, rpcError},
+        AggregateResult{connectionError, rpcError},
+        AggregateResult{connectionError}};
+    EXPECT_EQ(seen.size(), 2u);
+}
+
+}  // namespace result_map_tests
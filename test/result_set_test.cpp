@@ -0,0 +1,172 @@
+#include "respp/result_set.hpp"
+
+#include "constant_evaluation.hpp"
+
+#include <gtest/gtest.h>
+
+namespace result_set_tests
+{
+using test_helpers::is_constant;
+
+MAKE_RESULT_CATEGORY(Domain, 2);
+MAKE_RESULT_CATEGORY(SubDomain, 2);
+MAKE_RESULT_TYPE(TestResult, uint8_t, Domain, SubDomain);
+MAKE_RESULT_TYPE(WideTestResult, uint32_t, Domain, SubDomain);
+
+constexpr auto Networking = Domain{1};
+constexpr auto Backend = Domain{2};
+
+constexpr auto Tcp = SubDomain{1};
+constexpr auto Db = SubDomain{1};
+constexpr auto Rpc = SubDomain{2};
+
+constexpr auto connectionError = TestResult::make(Networking, Tcp, 1);
+constexpr auto timeoutError = TestResult::make(Networking, Tcp, 2);
+constexpr auto queryError = TestResult::make(Backend, Db, 1);
+constexpr auto rpcError = TestResult::make(Backend, Rpc, 1);
+
+constexpr respp::result_set<TestResult> retryable{
+    connectionError, timeoutError, rpcError};
+constexpr respp::result_set<TestResult> backend{queryError, rpcError};
+
+static_assert(respp::result_set<TestResult>::is_direct, "");
+static_assert(!respp::result_set<WideTestResult>::is_direct, "");
+static_assert(
+    retryable.contains(timeoutError),
+    "Membership should be evaluated at compile time");
+
+TEST(ResultSet_8bit, Membership_of_every_value)
+{
+    for (auto v = 0; v <= UINT8_MAX; ++v) {
+        TestResult const r{static_cast<uint8_t>(v)};
+        EXPECT_EQ(
+            retryable.contains(r),
+            r == connectionError || r == timeoutError || r == rpcError)
+            << v;
+    }
+}
+
+TEST(ResultSet_8bit, Union_and_intersection)
+{
+    constexpr auto retryable_or_backend = retryable | backend;
+    constexpr auto retryable_backend = retryable & backend;
+
+    EXPECT_TRUE(retryable_or_backend.contains(queryError));
+    EXPECT_TRUE(retryable_or_backend.contains(connectionError));
+    EXPECT_FALSE(retryable_or_backend.contains(TestResult::success));
+
+    EXPECT_TRUE(retryable_backend.contains(rpcError));
+    EXPECT_FALSE(retryable_backend.contains(queryError));
+    EXPECT_FALSE(retryable_backend.contains(connectionError));
+}
+
+TEST(ResultSet_8bit, Any_error_of_aggregate_result)
+{
+    using aggregate_result = respp::aggregate_result_t<uint32_t, TestResult>;
+
+    EXPECT_TRUE(retryable.contains_any(aggregate_result{queryError, rpcError}));
+    EXPECT_FALSE(retryable.contains_any(aggregate_result{queryError}));
+    EXPECT_FALSE(retryable.contains_any(aggregate_result{}));
+}
+
+TEST(ResultSet_32bit, Hashed_membership)
+{
+    respp::result_set<WideTestResult, 8> set{
+        WideTestResult::make(Backend, Rpc, 1),
+        WideTestResult::make(Backend, Rpc, 0x10000),
+        WideTestResult::make(Networking, Tcp, 7)};
+
+    EXPECT_TRUE(set.contains(WideTestResult::make(Backend, Rpc, 0x10000)));
+    EXPECT_TRUE(set.contains(WideTestResult::make(Networking, Tcp, 7)));
+    EXPECT_FALSE(set.contains(WideTestResult::make(Backend, Rpc, 2)));
+    EXPECT_FALSE(set.contains(WideTestResult::success));
+
+    EXPECT_TRUE(set.insert(WideTestResult::success));
+    EXPECT_TRUE(set.contains(WideTestResult::success));
+
+    for (uint32_t code = 100; code < 105; ++code)
+        EXPECT_TRUE(set.insert(WideTestResult::make(Backend, Db, code)));
+    EXPECT_FALSE(set.insert(WideTestResult::make(Backend, Db, 105)));
+    EXPECT_TRUE(set.contains(WideTestResult::make(Backend, Db, 104)));
+    EXPECT_FALSE(set.contains(WideTestResult::make(Backend, Db, 105)));
+}
+
+constexpr auto first = WideTestResult::make(Backend, Rpc, 1);
+constexpr auto second = WideTestResult::make(Backend, Rpc, 2);
+constexpr auto third = WideTestResult::make(Backend, Rpc, 3);
+constexpr auto fourth = WideTestResult::make(Backend, Db, 1);
+constexpr auto fifth = WideTestResult::make(Backend, Db, 2);
+constexpr auto sixth = WideTestResult::make(Backend, Db, 3);
+
+TEST(ResultSet_32bit, Union_and_intersection)
+{
+    using wide_set = respp::result_set<WideTestResult>;
+
+    constexpr wide_set lhs{first, second, WideTestResult::success};
+    constexpr wide_set rhs{second, third};
+
+    constexpr auto united = lhs | rhs;
+    EXPECT_TRUE(united.contains(first));
+    EXPECT_TRUE(united.contains(third));
+    EXPECT_TRUE(united.contains(WideTestResult::success));
+
+    constexpr auto common = lhs & rhs;
+    EXPECT_TRUE(common.contains(second));
+    EXPECT_FALSE(common.contains(first));
+    EXPECT_FALSE(common.contains(third));
+    EXPECT_FALSE(common.contains(WideTestResult::success));
+}
+
+using small_set = respp::result_set<WideTestResult, 4>;
+
+struct FullSet {
+    static constexpr small_set make()
+    {
+        return {first, second, third, fourth};
+    }
+};
+
+struct OverflowedSet {
+    static constexpr small_set make()
+    {
+        return {first, second, third, fourth, fifth};
+    }
+};
+
+struct OverflowedUnion {
+    static constexpr small_set make()
+    {
+        return small_set{first, second, third}
+               | small_set{fourth, fifth, sixth};
+    }
+};
+
+static_assert(is_constant<FullSet>(0), "");
+static_assert(
+    !is_constant<OverflowedSet>(0),
+    "Results not fitting the set should fail the constant initialization");
+static_assert(
+    !is_constant<OverflowedUnion>(0),
+    "Union not fitting the set should fail the constant evaluation");
+
+TEST(ResultSet_32bit, Overflow_is_observable)
+{
+    auto const full = FullSet::make();
+    EXPECT_FALSE(full.overflowed());
+    EXPECT_TRUE(full.contains(fourth));
+
+    auto const constructed = OverflowedSet::make();
+    EXPECT_TRUE(constructed.overflowed());
+
+    auto const united = OverflowedUnion::make();
+    EXPECT_TRUE(united.overflowed());
+    auto members = 0;
+    for (auto const r : {first, second, third, fourth, fifth, sixth})
+        members += united.contains(r);
+    EXPECT_EQ(members, 4);
+
+    EXPECT_TRUE((united & full).overflowed());
+    EXPECT_FALSE((full & full).overflowed());
+}
+
+}  // namespace result_set_tests
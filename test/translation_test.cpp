@@ -0,0 +1,169 @@
+#include "respp/errc_translation.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+
+namespace translation_tests
+{
+MAKE_RESULT_CATEGORY(Domain, 2);
+MAKE_RESULT_CATEGORY(SubDomain, 2);
+MAKE_RESULT_TYPE(TestResult, uint8_t, Domain, SubDomain);
+
+constexpr auto Remote = Domain{1};
+constexpr auto System = Domain{2};
+
+constexpr auto Http = SubDomain{1};
+constexpr auto Grpc = SubDomain{2};
+constexpr auto Os = SubDomain{1};
+
+constexpr auto unknownGrpcError = TestResult::make(Remote, Grpc, 15);
+constexpr auto cancelledError = TestResult::make(Remote, Grpc, 1);
+constexpr auto notFoundError = TestResult::make(Remote, Grpc, 2);
+constexpr auto unavailableError = TestResult::make(Remote, Grpc, 3);
+
+struct GrpcStatuses {
+    static constexpr auto mappings()
+    {
+        return respp::make_code_mappings<int, TestResult>(
+            unknownGrpcError,
+            {{0, TestResult::success},
+             {1, cancelledError},
+             {5, notFoundError},
+             {14, unavailableError}});
+    }
+};
+
+using from_grpc = respp::translation_t<GrpcStatuses>;
+
+static_assert(from_grpc::is_dense, "Compact code range should be dense");
+static_assert(
+    from_grpc::to_result(14) == unavailableError,
+    "Translation should be evaluated at compile time");
+
+TEST(Translation, Dense_table_translates_codes_in_range)
+{
+    EXPECT_EQ(from_grpc::code_range, 15u);
+    EXPECT_EQ(from_grpc::to_result(0), TestResult::success);
+    EXPECT_EQ(from_grpc::to_result(1), cancelledError);
+    EXPECT_EQ(from_grpc::to_result(5), notFoundError);
+    EXPECT_EQ(from_grpc::to_result(2), unknownGrpcError);
+    EXPECT_EQ(from_grpc::to_result(-1), unknownGrpcError);
+    EXPECT_EQ(from_grpc::to_result(16), unknownGrpcError);
+}
+
+constexpr auto unknownHttpError = TestResult::make(Remote, Http, 15);
+constexpr auto clientError = TestResult::make(Remote, Http, 1);
+constexpr auto throttledError = TestResult::make(Remote, Http, 2);
+constexpr auto serverError = TestResult::make(Remote, Http, 3);
+
+struct HttpStatuses {
+    static constexpr auto mappings()
+    {
+        // vendor specific status makes the range sparse
+        return respp::make_code_mappings<int, TestResult>(
+            unknownHttpError,
+            {{500, serverError},
+             {429, throttledError},
+             {400, clientError},
+             {20000, throttledError},
+             {404, clientError},
+             {503, serverError},
+             {200, TestResult::success}});
+    }
+};
+
+using from_http = respp::translation_t<HttpStatuses>;
+
+static_assert(!from_http::is_dense, "Sparse code range should be sorted");
+
+TEST(Translation, Sorted_table_translates_sparse_codes)
+{
+    EXPECT_EQ(from_http::to_result(200), TestResult::success);
+    EXPECT_EQ(from_http::to_result(400), clientError);
+    EXPECT_EQ(from_http::to_result(404), clientError);
+    EXPECT_EQ(from_http::to_result(429), throttledError);
+    EXPECT_EQ(from_http::to_result(503), serverError);
+    EXPECT_EQ(from_http::to_result(20000), throttledError);
+    EXPECT_EQ(from_http::to_result(401), unknownHttpError);
+    EXPECT_EQ(from_http::to_result(0), unknownHttpError);
+    EXPECT_EQ(from_http::to_result(30000), unknownHttpError);
+}
+
+TEST(Translation, Result_is_translated_back_to_the_first_declared_code)
+{
+    EXPECT_EQ(from_http::to_code(serverError, 0), 500);
+    EXPECT_EQ(from_http::to_code(throttledError, 0), 429);
+    EXPECT_EQ(from_http::to_code(clientError, 0), 400);
+    EXPECT_EQ(from_http::to_code(TestResult::success, 0), 200);
+    EXPECT_EQ(from_http::to_code(unknownGrpcError, 0), 0);
+
+    EXPECT_EQ(from_grpc::to_code(notFoundError, -1), 5);
+    EXPECT_EQ(from_grpc::to_code(clientError, -1), -1);
+}
+
+struct SystemErrors : respp::errno_table<SystemErrors> {
+    static constexpr TestResult make(respp::errc_code code)
+    {
+        return TestResult::make(System, Os, static_cast<uint8_t>(code));
+    }
+};
+
+struct SystemConditions : respp::errc_table<SystemConditions> {
+    static constexpr TestResult make(respp::errc_code code)
+    {
+        return SystemErrors::make(code);
+    }
+};
+
+using from_errno = respp::translation_t<SystemErrors>;
+using from_errc = respp::translation_t<SystemConditions>;
+
+TEST(Translation, Default_errno_table_groups_system_errors)
+{
+    EXPECT_TRUE(from_errno::is_dense);
+
+    EXPECT_EQ(
+        from_errno::to_result(EACCES),
+        SystemErrors::make(respp::errc_code::permission_denied));
+    EXPECT_EQ(
+        from_errno::to_result(ENOENT),
+        SystemErrors::make(respp::errc_code::not_found));
+    EXPECT_EQ(
+        from_errno::to_result(EWOULDBLOCK),
+        SystemErrors::make(respp::errc_code::busy));
+    EXPECT_EQ(
+        from_errno::to_result(ECONNRESET),
+        SystemErrors::make(respp::errc_code::connection_failure));
+    EXPECT_EQ(from_errno::to_result(0), TestResult::success);
+    EXPECT_EQ(from_errno::to_code(TestResult::success, -1), 0);
+    EXPECT_EQ(
+        from_errno::to_result(-1),
+        SystemErrors::make(respp::errc_code::other));
+
+    EXPECT_EQ(
+        from_errno::to_code(
+            SystemErrors::make(respp::errc_code::timed_out), 0),
+        ETIMEDOUT);
+}
+
+TEST(Translation, Default_errc_table_groups_error_conditions)
+{
+    EXPECT_EQ(
+        from_errc::to_result(std::errc::no_space_on_device),
+        SystemErrors::make(respp::errc_code::out_of_resources));
+    EXPECT_EQ(
+        from_errc::to_result(std::errc::interrupted),
+        SystemErrors::make(respp::errc_code::interrupted));
+    EXPECT_EQ(from_errc::to_result(std::errc{}), TestResult::success);
+    EXPECT_EQ(
+        from_errc::to_code(TestResult::success, std::errc::not_supported),
+        std::errc{});
+    EXPECT_EQ(
+        from_errc::to_code(
+            SystemErrors::make(respp::errc_code::io_error),
+            std::errc::not_supported),
+        std::errc::io_error);
+}
+
+}  // namespace translation_tests
@@ -0,0 +1,91 @@
+#include "respp/error_tree.hpp"
+#include "respp/try.hpp"
+
+#include <gtest/gtest.h>
+
+namespace try_tests
+{
+MAKE_RESULT_CATEGORY(Domain, 2);
+MAKE_RESULT_CATEGORY(SubDomain, 2);
+MAKE_RESULT_TYPE(TestResult, uint8_t, Domain, SubDomain);
+MAKE_AGGREGATE_RESULT_TYPE(AggregateResult, uint32_t, TestResult);
+MAKE_ERROR_TREE_TYPE(ErrorTree, TestResult, 4);
+
+constexpr auto Networking = Domain{1};
+constexpr auto Application = Domain{3};
+
+constexpr auto Tcp = SubDomain{1};
+constexpr auto Server = SubDomain{1};
+constexpr auto Client = SubDomain{2};
+
+constexpr auto connectionError = TestResult::make(Networking, Tcp, 1);
+constexpr auto rpcError = TestResult::make(Application, Client, 1);
+constexpr auto requestError = TestResult::make(Application, Server, 1);
+
+TestResult connect(bool fail)
+{
+    return fail ? connectionError : TestResult::success;
+}
+
+AggregateResult call(bool fail)
+{
+    RESPP_TRY(connect(fail), rpcError);
+    return {};
+}
+
+AggregateResult handle(bool fail, int &completed)
+{
+    RESPP_TRY(call(fail), requestError);
+    ++completed;
+    return {};
+}
+
+ErrorTree handleWithTree(bool fail)
+{
+    RESPP_TRY(connect(fail), rpcError);
+    return {};
+}
+
+ErrorTree handleCallWithTree(bool fail)
+{
+    RESPP_TRY(call(fail), requestError);
+    return {};
+}
+
+TEST(Try, Success_continues_execution)
+{
+    auto completed = 0;
+
+    EXPECT_TRUE(respp::is_success(handle(false, completed)));
+    EXPECT_EQ(completed, 1);
+}
+
+TEST(Try, Failure_returns_early_with_context_of_every_layer)
+{
+    auto completed = 0;
+    auto const result = handle(true, completed);
+
+    EXPECT_EQ(completed, 0);
+    EXPECT_EQ(
+        result, (AggregateResult{connectionError, rpcError, requestError}));
+}
+
+TEST(Try, Failure_is_propagated_to_error_tree)
+{
+    EXPECT_TRUE(respp::is_success(handleWithTree(false)));
+
+    auto const result = handleWithTree(true);
+    EXPECT_EQ(result, (ErrorTree{connectionError, rpcError}));
+    EXPECT_EQ(result[result.root()], rpcError);
+}
+
+TEST(Try, Aggregate_failure_is_propagated_to_error_tree)
+{
+    EXPECT_TRUE(respp::is_success(handleCallWithTree(false)));
+
+    auto const result = handleCallWithTree(true);
+    EXPECT_EQ(result, (ErrorTree{connectionError, rpcError, requestError}));
+    EXPECT_EQ(result[result.root()], requestError);
+}
+
+}  // namespace try_tests